@@ -0,0 +1,1356 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include "ParticleKernels.h"
+#include "CollisionSolver.h"
+#include "ThreadPool.h"
+
+#define VALIDATION_CHECKED_FRAMES 8
+#define VALIDATION_FRAMES 100
+
+namespace
+{
+	/// Conditia de suprapunere folosita de referinta bruta.
+	enum class OverlapTest
+	{
+		Boxes,		// dreptunghiurile incadratoare, cu marginile incluse (ca BvhContainer si SweepAndPruneContainer)
+		Circles		// cercurile, ca CheckCollisionCircles
+	};
+
+	// referinta bruta: toate perechile (i, j), i < j, care se suprapun, in ordine lexicografica
+	std::vector<std::pair<int, int>> bruteForcePairs(const ParticleStore& state, OverlapTest test)
+	{
+		std::vector<std::pair<int, int>> pairs;
+		int count = (int)state.size();
+
+		for (int i = 0; i < count; i++)
+			for (int j = i + 1; j < count; j++)
+			{
+				bool overlapping = test == OverlapTest::Boxes ?
+					state.x[i] - state.radius[i] <= state.x[j] + state.radius[j] && state.x[j] - state.radius[j] <= state.x[i] + state.radius[i] &&
+					state.y[i] - state.radius[i] <= state.y[j] + state.radius[j] && state.y[j] - state.radius[j] <= state.y[i] + state.radius[i] :
+					CheckCollisionCircles(state.getPosition(i), state.radius[i], state.getPosition(j), state.radius[j]);
+				if (overlapping)
+					pairs.emplace_back(i, j);
+			}
+
+		return pairs;
+	}
+}
+
+Benchmark::Benchmark(int screenWidth, int screenHeight, const BenchmarkConfig& config) :
+	screenWidth(screenWidth),
+	screenHeight(screenHeight),
+	config(config),
+	pm(screenWidth, screenHeight, measurementCollector)
+{
+	pm.setBvhOptions(config.bvhOptions);
+	pm.setQuadTreeOptions(config.quadTreeOptions);
+	pm.setGridOptions(config.gridOptions);
+	if (config.workers >= 0)
+		pm.setWorkerCount(config.workers);
+}
+
+bool Benchmark::parseArguments(int argc, char** argv, BenchmarkConfig& config)
+{
+	auto splitList = [](const std::string& input)
+	{
+		std::vector<std::string> tokens;
+		std::stringstream ss(input);
+		std::string token;
+		while (std::getline(ss, token, ','))
+			if (!token.empty())
+				tokens.push_back(token);
+		return tokens;
+	};
+
+	// --validate are valori implicite mai mici, daca numerele de particule si de cadre nu sunt date explicit
+	bool countsGiven = false;
+	bool framesGiven = false;
+
+	try
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			std::string arg = argv[i];
+
+			if (arg == "--help" || arg == "-h")
+				return false;
+
+			if (arg == "--validate")
+			{
+				config.validate = true;
+				continue;
+			}
+
+			if (arg == "--bvh-stats")
+			{
+				config.bvhStats = true;
+				continue;
+			}
+
+			if (i + 1 >= argc)
+			{
+				std::cout << "Lipseste valoarea pentru " << arg << "\n";
+				return false;
+			}
+			std::string value = argv[++i];
+
+			if (arg == "--sizes")
+			{
+				countsGiven = true;
+				config.particleCounts.clear();
+				for (const auto& token : splitList(value))
+					config.particleCounts.push_back(std::stoi(token));
+			}
+			else if (arg == "--sweep")
+			{
+				// start:end:step
+				std::vector<int> parts;
+				std::stringstream ss(value);
+				std::string token;
+				while (std::getline(ss, token, ':'))
+					parts.push_back(std::stoi(token));
+				if (parts.size() != 3 || parts[2] <= 0 || parts[0] > parts[1])
+				{
+					std::cout << "Format invalid pentru --sweep, se asteapta start:end:step\n";
+					return false;
+				}
+				countsGiven = true;
+				config.particleCounts.clear();
+				for (int n = parts[0]; n <= parts[1]; n += parts[2])
+					config.particleCounts.push_back(n);
+			}
+			else if (arg == "--frames")
+			{
+				framesGiven = true;
+				config.frames = std::stoi(value);
+			}
+			else if (arg == "--warmup")
+				config.warmupFrames = std::stoi(value);
+			else if (arg == "--seed")
+				config.seed = static_cast<unsigned int>(std::stoul(value));
+			else if (arg == "--dt")
+				config.deltaT = std::stof(value);
+			else if (arg == "--csv")
+				config.csvPath = value;
+			else if (arg == "--bvh-update")
+			{
+				if (value == "refit")
+					config.bvhOptions.updateMode = BvhUpdateMode::Refit;
+				else if (value == "rebuild")
+					config.bvhOptions.updateMode = BvhUpdateMode::Rebuild;
+				else
+				{
+					std::cout << "Mod de actualizare BVH necunoscut: " << value << "\n";
+					return false;
+				}
+			}
+			else if (arg == "--bvh-rebuild-threshold")
+				config.bvhOptions.rebuildThreshold = std::stof(value);
+			else if (arg == "--bvh-builder")
+			{
+				if (value == "midpoint")
+					config.bvhOptions.builder = BvhBuilder::Midpoint;
+				else if (value == "sah")
+					config.bvhOptions.builder = BvhBuilder::BinnedSah;
+				else if (value == "lbvh")
+					config.bvhOptions.builder = BvhBuilder::Lbvh;
+				else
+				{
+					std::cout << "Builder BVH necunoscut: " << value << "\n";
+					return false;
+				}
+			}
+			else if (arg == "--bvh-bins")
+				config.bvhOptions.binCount = std::stoi(value);
+			else if (arg == "--bvh-leaf-size")
+				config.bvhOptions.maxLeafSize = std::stoi(value);
+			else if (arg == "--bvh-parallel-build")
+			{
+				if (value == "on")
+					config.bvhOptions.parallelBuild = true;
+				else if (value == "off")
+					config.bvhOptions.parallelBuild = false;
+				else
+				{
+					std::cout << "Valoare invalida pentru --bvh-parallel-build: " << value << "\n";
+					return false;
+				}
+			}
+			else if (arg == "--bvh-parallel-threshold")
+				config.bvhOptions.parallelBuildThreshold = std::stoi(value);
+			else if (arg == "--workers")
+				config.workers = std::stoi(value);
+			else if (arg == "--quadtree-looseness")
+				config.quadTreeOptions.looseness = std::stof(value);
+			else if (arg == "--quadtree-update")
+			{
+				if (value == "incremental")
+					config.quadTreeOptions.updateMode = QuadTreeUpdateMode::Incremental;
+				else if (value == "rebuild")
+					config.quadTreeOptions.updateMode = QuadTreeUpdateMode::Rebuild;
+				else
+				{
+					std::cout << "Valoare invalida pentru --quadtree-update: " << value << "\n";
+					return false;
+				}
+			}
+			else if (arg == "--grid-update")
+			{
+				if (value == "counting-sort")
+					config.gridOptions.updateMode = GridUpdateMode::CountingSort;
+				else if (value == "incremental")
+					config.gridOptions.updateMode = GridUpdateMode::Incremental;
+				else
+				{
+					std::cout << "Valoare invalida pentru --grid-update: " << value << "\n";
+					return false;
+				}
+			}
+			else if (arg == "--grid-layout")
+			{
+				if (value == "dense")
+					config.gridOptions.layout = GridLayout::Dense;
+				else if (value == "hash")
+					config.gridOptions.layout = GridLayout::SparseHash;
+				else
+				{
+					std::cout << "Valoare invalida pentru --grid-layout: " << value << "\n";
+					return false;
+				}
+			}
+			else if (arg == "--grid-cell")
+			{
+				if (value == "auto")
+					config.gridOptions.autoCellSize = true;
+				else if (value == "fixed")
+					config.gridOptions.autoCellSize = false;
+				else
+				{
+					std::cout << "Valoare invalida pentru --grid-cell: " << value << "\n";
+					return false;
+				}
+			}
+			else if (arg == "--grid-solve")
+			{
+				if (value == "global")
+					config.gridOptions.solveMode = GridSolveMode::Global;
+				else if (value == "colored")
+					config.gridOptions.solveMode = GridSolveMode::ColoredCells;
+				else
+				{
+					std::cout << "Valoare invalida pentru --grid-solve: " << value << "\n";
+					return false;
+				}
+			}
+			else if (arg == "--grid-cell-percentile")
+				config.gridOptions.cellSizePercentile = std::stof(value);
+			else if (arg == "--quadtree-max-depth")
+				config.quadTreeOptions.maxDepth = std::stoi(value);
+			else if (arg == "--quadtree-split")
+				config.quadTreeOptions.splitThreshold = std::stoi(value);
+			else if (arg == "--quadtree-merge")
+				config.quadTreeOptions.mergeThreshold = std::stoi(value);
+			else if (arg == "--algos")
+			{
+				config.algorithms.clear();
+				for (const auto& token : splitList(value))
+				{
+					if (token == "quadtree" || token == "qtree")
+						config.algorithms.push_back(Algo::QuadTree);
+					else if (token == "grid" || token == "spatialhashing")
+						config.algorithms.push_back(Algo::Grid);
+					else if (token == "bvh" || token == "boundingvolumehierarchy")
+						config.algorithms.push_back(Algo::BoundingVolume);
+					else if (token == "sap" || token == "sweepandprune")
+						config.algorithms.push_back(Algo::SweepAndPrune);
+					else if (token == "bruteforce" || token == "brute")
+						config.algorithms.push_back(Algo::BruteForce);
+					else
+					{
+						std::cout << "Algoritm necunoscut: " << token << "\n";
+						return false;
+					}
+				}
+			}
+			else
+			{
+				std::cout << "Argument necunoscut: " << arg << "\n";
+				return false;
+			}
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << "Eroare la interpretarea argumentelor: " << e.what() << "\n";
+		return false;
+	}
+
+	if (config.validate && !countsGiven)
+		config.particleCounts = { 500, 2000, 5000 };
+	if (config.validate && !framesGiven)
+		config.frames = VALIDATION_FRAMES;
+
+	if (config.particleCounts.empty() || config.algorithms.empty() || config.frames <= 0 || config.warmupFrames < 0 ||
+		config.bvhOptions.maxLeafSize < 1)
+	{
+		std::cout << "Configuratie invalida: sunt necesare cel putin un numar de particule, un algoritm si un cadru\n";
+		return false;
+	}
+
+	return true;
+}
+
+void Benchmark::printUsage()
+{
+	std::cout << "Utilizare: benchmark [optiuni]\n";
+	std::cout << "  --sizes 1000,5000,10000   numerele de particule\n";
+	std::cout << "  --sweep start:end:step    numerele de particule ca interval\n";
+	std::cout << "  --frames N                cadre masurate (implicit 300)\n";
+	std::cout << "  --warmup N                cadre rulate inainte de masurare (implicit 10)\n";
+	std::cout << "  --seed N                  samanta pentru generarea particulelor (implicit 42)\n";
+	std::cout << "  --algos quadtree,grid,bvh,sap,bruteforce algoritmii masurati\n";
+	std::cout << "  --dt valoare              pasul de timp pe cadru (implicit 0.15)\n";
+	std::cout << "  --csv fisier              scrie rezultatele intr-un fisier CSV\n";
+	std::cout << "  --validate                ruleaza verificarile de corectitudine in locul masuratorilor\n";
+	std::cout << "                            (implicit cu --sizes 500,2000,5000 --frames 100)\n";
+	std::cout << "  --bvh-update refit|rebuild actualizarea BVH la fiecare cadru (implicit refit)\n";
+	std::cout << "  --bvh-rebuild-threshold v reconstruieste BVH cand costul SAH creste de v ori (implicit 1.3)\n";
+	std::cout << "  --bvh-builder midpoint|sah|lbvh constructia BVH (implicit midpoint)\n";
+	std::cout << "  --bvh-bins N              numarul de intervale pentru builder-ul sah (implicit 8)\n";
+	std::cout << "  --bvh-leaf-size N         numarul maxim de Box-uri intr-o frunza fortata (implicit 2)\n";
+	std::cout << "  --bvh-parallel-build on|off construieste subarborii mari ai BVH in paralel (implicit on)\n";
+	std::cout << "  --bvh-parallel-threshold N subarborii cu mai putin de N Box-uri se construiesc serial (implicit 4096)\n";
+	std::cout << "  --quadtree-looseness v    marirea nodurilor QuadTree (1 = strict, 2 = loose; implicit 2)\n";
+	std::cout << "  --quadtree-update incremental|rebuild actualizarea QuadTree la fiecare cadru (implicit incremental)\n";
+	std::cout << "  --quadtree-max-depth N    numarul maxim de niveluri QuadTree (implicit 12)\n";
+	std::cout << "  --quadtree-split N        imparte o frunza QuadTree peste N elemente (0 = impartire geometrica; implicit 16)\n";
+	std::cout << "  --quadtree-merge N        uneste copiii QuadTree cu cel mult N elemente la eliminare (implicit 8)\n";
+	std::cout << "  --grid-update counting-sort|incremental actualizarea Grid la fiecare cadru (implicit counting-sort)\n";
+	std::cout << "  --grid-layout dense|hash  reteaua Grid densa sau tabela de dispersie fara limite (implicit dense)\n";
+	std::cout << "  --grid-cell auto|fixed    celula Grid din diametrele particulelor sau 50 x 96 celule fixe (implicit auto)\n";
+	std::cout << "  --grid-cell-percentile p  percentila diametrelor folosita ca latura a celulei (implicit 100 = maximul)\n";
+	std::cout << "  --grid-solve global|colored rezolvarea Grid prin CollisionSolver sau pe culori de celule, in paralel (implicit global)\n";
+	std::cout << "  --workers N               fire suplimentare pentru pasii paraleli ai fiecarui cadru (implicit nuclee - 1)\n";
+	std::cout << "  --bvh-stats               afiseaza calitatea arborelui BVH pentru fiecare builder\n";
+}
+
+std::string Benchmark::algoName(Algo algo)
+{
+	switch (algo)
+	{
+	case Algo::QuadTree:
+		return "QuadTree";
+	case Algo::Grid:
+		return "Grid";
+	case Algo::BoundingVolume:
+		return "BVH";
+	case Algo::SweepAndPrune:
+		return "SAP";
+	case Algo::BruteForce:
+		return "BruteForce";
+	}
+	return "Unknown";
+}
+
+std::vector<BenchmarkResult> Benchmark::run()
+{
+	std::vector<BenchmarkResult> results;
+
+	std::cout << "Fire de executie pe cadru: " << pm.getThreadCount() << "\n";
+
+	for (int particles : config.particleCounts)
+	{
+		for (Algo algo : config.algorithms)
+		{
+			std::cout << "Ruleaza " << algoName(algo) << " pentru " << particles << " particule\n";
+			results.push_back(runOne(algo, particles));
+		}
+	}
+
+	return results;
+}
+
+void Benchmark::startAlgo(Algo algo, int particles)
+{
+	// aceeasi stare initiala pentru fiecare algoritm
+	pm.setSeed(config.seed);
+	pm.InitParticles(particles);
+
+	if (algo == Algo::QuadTree)
+		pm.startQuadTree();
+	else if (algo == Algo::Grid)
+		pm.startGrid();
+	else if (algo == Algo::BoundingVolume)
+		pm.startBoundingVolume();
+	else if (algo == Algo::SweepAndPrune)
+		pm.startSweepAndPrune();
+	else if (algo == Algo::BruteForce)
+		pm.startBruteForce();
+}
+
+ParticleStore Benchmark::simulate(Algo algo, int particles, std::vector<std::vector<std::pair<int, int>>>* contacts)
+{
+	startAlgo(algo, particles);
+
+	for (int frame = 0; frame < config.frames; frame++)
+	{
+		pm.updateParticles(config.deltaT);
+		if (contacts != nullptr)
+			contacts->push_back(pm.getContacts());
+	}
+
+	return pm.getParticles();
+}
+
+bool Benchmark::isCheckedFrame(int frame) const
+{
+	int stride = std::max(1, config.frames / VALIDATION_CHECKED_FRAMES);
+	return frame % stride == 0 || frame == config.frames / 2 || frame == config.frames - 1;
+}
+
+bool Benchmark::statesEqual(const ParticleStore& first, const ParticleStore& second)
+{
+	size_t bytes = first.size() * sizeof(float);
+	return first.size() == second.size() &&
+		std::memcmp(first.x.data(), second.x.data(), bytes) == 0 &&
+		std::memcmp(first.y.data(), second.y.data(), bytes) == 0 &&
+		std::memcmp(first.vx.data(), second.vx.data(), bytes) == 0 &&
+		std::memcmp(first.vy.data(), second.vy.data(), bytes) == 0;
+}
+
+BenchmarkResult Benchmark::runOne(Algo algo, int particles)
+{
+	startAlgo(algo, particles);
+
+	for (int i = 0; i < config.warmupFrames; i++)
+		pm.updateParticles(config.deltaT);
+
+	std::vector<double> frameTimes;
+	frameTimes.reserve(config.frames);
+
+	for (int i = 0; i < config.frames; i++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		pm.updateParticles(config.deltaT);
+		auto end = std::chrono::steady_clock::now();
+
+		std::chrono::duration<double, std::milli> duration = end - start;
+		frameTimes.push_back(duration.count());
+	}
+
+	std::sort(frameTimes.begin(), frameTimes.end());
+
+	BenchmarkResult result;
+	result.algo = algo;
+	result.particles = particles;
+	result.frames = config.frames;
+	result.mean = std::accumulate(frameTimes.begin(), frameTimes.end(), 0.0) / frameTimes.size();
+	result.median = percentile(frameTimes, 50.0);
+	result.p95 = percentile(frameTimes, 95.0);
+	result.p99 = percentile(frameTimes, 99.0);
+	result.min = frameTimes.front();
+	result.max = frameTimes.back();
+
+	return result;
+}
+
+bool Benchmark::validate()
+{
+	bool passed = true;
+
+	for (int particles : config.particleCounts)
+	{
+		passed = validateSimdKernels(particles) && passed;
+		passed = validateCollisionSolver(particles) && passed;
+		passed = validateBvh(particles) && passed;
+		passed = validateBvhParallelBuild(particles) && passed;
+		passed = validateQuadTree(particles) && passed;
+		passed = validateGrid(particles) && passed;
+		passed = validateSpatialHash(particles) && passed;
+		passed = validateSweepAndPrune(particles) && passed;
+		passed = validateBruteForce(particles) && passed;
+		passed = validateWorkerCounts(particles) && passed;
+		passed = validateGridColored(particles) && passed;
+	}
+
+	std::cout << (passed ? "Toate verificarile au trecut\n" : "Unele verificari au esuat\n");
+	return passed;
+}
+
+bool Benchmark::validateSimdKernels(int particles)
+{
+	std::mt19937 generator(config.seed);
+	std::uniform_real_distribution<float> xDistrib(-20.f, screenWidth + 20.f);
+	std::uniform_real_distribution<float> yDistrib(-20.f, screenHeight + 20.f);
+	std::uniform_real_distribution<float> radiusDistrib(4.1f, 8.9f);
+	std::uniform_real_distribution<float> directionDistrib(-5.f, 5.f);
+
+	// particule si in afara cadrului, cu directii oarecare, ca sa fie atinse toate ramurile de reflexie
+	ParticleStore reference;
+	for (int i = 0; i < particles; i++)
+	{
+		float x = xDistrib(generator);
+		float y = yDistrib(generator);
+		float radius = radiusDistrib(generator);
+		float vx = directionDistrib(generator);
+		float vy = directionDistrib(generator);
+		reference.add(radius, Vector2{ x, y }, Vector2{ vx, vy });
+	}
+
+	std::vector<ParticleStore> candidates;
+	std::vector<SimdLevel> levels{ SimdLevel::SSE, SimdLevel::AVX2, SimdLevel::AVX512 };
+	for (SimdLevel level : levels)
+		if (level <= ParticleKernels::detectSimdLevel())
+			candidates.push_back(reference);
+
+	for (int frame = 0; frame < config.frames; frame++)
+	{
+		ParticleKernels::integrateAndReflect(reference, 0, reference.size(), config.deltaT, screenWidth, screenHeight, SimdLevel::Scalar);
+		for (size_t i = 0; i < candidates.size(); i++)
+			ParticleKernels::integrateAndReflect(candidates[i], 0, candidates[i].size(), config.deltaT, screenWidth, screenHeight, levels[i]);
+	}
+
+	bool passed = true;
+	for (size_t i = 0; i < candidates.size(); i++)
+	{
+		bool identical = statesEqual(reference, candidates[i]);
+
+		std::cout << "Kernel " << ParticleKernels::simdLevelName(levels[i]) << " vs Scalar, " << particles << " particule, "
+			<< config.frames << " cadre: " << (identical ? "identic" : "DIFERIT") << "\n";
+		passed = passed && identical;
+	}
+
+	return passed;
+}
+
+bool Benchmark::validateCollisionSolver(int particles)
+{
+	ParticleStore initial = generateParticles(particles, false);
+
+	// acelasi scenariu, cu numar diferit de fire si cu perechile candidate in alta ordine (si duplicate)
+	auto simulate = [&](size_t workers, unsigned int shuffleSeed)
+	{
+		ThreadPool pool(workers);
+		CollisionSolver solver(pool);
+		ParticleStore state = initial;
+		std::mt19937 shuffler(shuffleSeed);
+		std::vector<int> order(particles);
+		std::vector<std::pair<int, int>> candidates;
+
+		for (int frame = 0; frame < config.frames; frame++)
+		{
+			ParticleKernels::integrateAndReflect(state, config.deltaT, screenWidth, screenHeight);
+
+			// perechi candidate prin baleiere pe axa X
+			std::iota(order.begin(), order.end(), 0);
+			std::sort(order.begin(), order.end(), [&](int a, int b) { return state.x[a] - state.radius[a] < state.x[b] - state.radius[b]; });
+			candidates.clear();
+			for (int i = 0; i < particles; i++)
+			{
+				int a = order[i];
+				for (int j = i + 1; j < particles && state.x[order[j]] - state.radius[order[j]] <= state.x[a] + state.radius[a]; j++)
+				{
+					candidates.emplace_back(a, order[j]);
+					if (shuffleSeed != 0)
+						candidates.emplace_back(order[j], a);
+				}
+			}
+			if (shuffleSeed != 0)
+				std::shuffle(candidates.begin(), candidates.end(), shuffler);
+
+			solver.clear();
+			for (const auto& candidate : candidates)
+				solver.addCandidate(candidate.first, candidate.second);
+			solver.solve(state);
+		}
+
+		return state;
+	};
+
+	ParticleStore reference = simulate(0, 0);
+
+	bool passed = true;
+	std::vector<size_t> workerCounts{ 1, 3, 7 };
+	for (size_t i = 0; i < workerCounts.size(); i++)
+	{
+		ParticleStore candidate = simulate(workerCounts[i], static_cast<unsigned int>(i + 1));
+		bool identical = statesEqual(reference, candidate);
+
+		std::cout << "CollisionSolver cu " << workerCounts[i] + 1 << " fire vs 1 fir, " << particles << " particule, "
+			<< config.frames << " cadre: " << (identical ? "identic" : "DIFERIT") << "\n";
+		passed = passed && identical;
+	}
+
+	return passed;
+}
+
+bool Benchmark::validateBvh(int particles)
+{
+	ParticleStore initial = generateParticles(particles, false);
+
+	bool passed = true;
+	std::vector<std::pair<BvhBuilder, BvhUpdateMode>> variants{
+		{ BvhBuilder::Midpoint, BvhUpdateMode::Rebuild }, { BvhBuilder::Midpoint, BvhUpdateMode::Refit },
+		{ BvhBuilder::BinnedSah, BvhUpdateMode::Rebuild }, { BvhBuilder::BinnedSah, BvhUpdateMode::Refit },
+		{ BvhBuilder::Lbvh, BvhUpdateMode::Rebuild }, { BvhBuilder::Lbvh, BvhUpdateMode::Refit } };
+	for (const auto& variant : variants)
+	{
+		BvhOptions options = config.bvhOptions;
+		options.builder = variant.first;
+		options.updateMode = variant.second;
+		BvhUpdateMode mode = variant.second;
+
+		ParticleStore state = initial;
+		BvhContainer<ParticleStore> bvh(state, options);
+		bvh.buildBVH();
+
+		bool identical = true;
+		size_t bvhPairs = 0;
+		size_t expectedPairs = 0;
+		for (int frame = 0; frame < config.frames && identical; frame++)
+		{
+			ParticleKernels::integrateAndReflect(state, config.deltaT, screenWidth, screenHeight);
+			bvh.update(0, state);
+			if (!isCheckedFrame(frame))
+				continue;
+
+			auto pairs = bvh.detectCollisions();
+			bvhPairs = pairs.size();
+			for (auto& pair : pairs)
+				if (pair.first > pair.second)
+					std::swap(pair.first, pair.second);
+			std::sort(pairs.begin(), pairs.end());
+
+			// aceeasi conditie ca BvhContainer::areBoxesColliding
+			auto expected = bruteForcePairs(state, OverlapTest::Boxes);
+			expectedPairs = expected.size();
+
+			// comparatia include numarul de perechi, deci si eventualele duplicate
+			identical = pairs == expected;
+		}
+
+		std::cout << "BVH (" << bvhBuilderName(options.builder) << ", " << (mode == BvhUpdateMode::Refit ? "refit" : "rebuild") << ") vs brut, " << particles << " particule, "
+			<< config.frames << " cadre: " << (identical ? "identic" : "DIFERIT") << " (" << bvhPairs << " / " << expectedPairs << " perechi)\n";
+		passed = passed && identical;
+	}
+
+	return passed;
+}
+
+bool Benchmark::validateBvhParallelBuild(int particles)
+{
+	bool passed = true;
+
+	for (bool clustered : { false, true })
+	{
+		ParticleStore state = generateParticles(particles, clustered);
+
+		for (BvhBuilder builder : { BvhBuilder::Midpoint, BvhBuilder::BinnedSah, BvhBuilder::Lbvh })
+		{
+			BvhOptions options = config.bvhOptions;
+			options.builder = builder;
+			options.parallelBuild = false;
+
+			BvhContainer<ParticleStore> reference(state, options);
+			reference.buildBVH();
+
+			// prag mic, ca sa fie create multe sarcini chiar si pentru putine particule
+			options.parallelBuild = true;
+			options.parallelBuildThreshold = 64;
+
+			for (size_t workers : { 1, 3, 7 })
+			{
+				ThreadPool pool(workers);
+				BvhContainer<ParticleStore> candidate(state, options, &pool);
+				candidate.buildBVH();
+
+				bool identical = reference.getNodesUsed() == candidate.getNodesUsed();
+				for (int i = 0; identical && i < reference.getNodesUsed(); i++)
+				{
+					const Node& a = reference.getBvhNodes()[i];
+					const Node& b = candidate.getBvhNodes()[i];
+					identical = a.leftChild == b.leftChild && a.firstBox == b.firstBox && a.boxCount == b.boxCount &&
+						a.aabbMin.x == b.aabbMin.x && a.aabbMin.y == b.aabbMin.y && a.aabbMax.x == b.aabbMax.x && a.aabbMax.y == b.aabbMax.y;
+				}
+				for (int i = 0; identical && i < particles; i++)
+					identical = reference.getBoxes()[i].id == candidate.getBoxes()[i].id;
+
+				std::cout << "Constructie BVH (" << bvhBuilderName(builder) << ", " << (clustered ? "grupata" : "uniforma") << ") cu "
+					<< workers + 1 << " fire vs serial, " << particles << " particule: " << (identical ? "identic" : "DIFERIT") << "\n";
+				passed = passed && identical;
+			}
+		}
+	}
+
+	return passed;
+}
+
+bool Benchmark::validateQuadTree(int particles)
+{
+	struct Variant
+	{
+		const char* name;
+		float looseness;
+		int splitThreshold;
+		QuadTreeUpdateMode updateMode;
+	};
+	const Variant variants[] = {
+		{ "strict, geometric, rebuild", 1.f, 0, QuadTreeUpdateMode::Rebuild },
+		{ "loose, geometric, rebuild", 2.f, 0, QuadTreeUpdateMode::Rebuild },
+		{ "strict, adaptiv, rebuild", 1.f, 8, QuadTreeUpdateMode::Rebuild },
+		{ "loose, adaptiv, rebuild", 2.f, 8, QuadTreeUpdateMode::Rebuild },
+		{ "strict, geometric, incremental", 1.f, 0, QuadTreeUpdateMode::Incremental },
+		{ "loose, adaptiv, incremental", 2.f, 8, QuadTreeUpdateMode::Incremental },
+	};
+
+	bool passed = true;
+
+	for (const Variant& variant : variants)
+	{
+		QuadTreeOptions options = config.quadTreeOptions;
+		options.looseness = variant.looseness;
+		options.splitThreshold = variant.splitThreshold;
+		options.mergeThreshold = variant.splitThreshold / 2;
+		options.updateMode = variant.updateMode;
+
+		ParticleStore state = generateParticles(particles, false);
+
+		StaticQuadTreeContainer<ParticleStore> quadTree(Rectangle{ 0.f, 0.f, static_cast<float>(screenWidth), static_cast<float>(screenHeight) }, 0, options);
+		for (int id = 0; id < particles; id++)
+			quadTree.insert(id, state.getRectangle(id));
+
+		std::vector<char> present(particles, 1);
+		std::vector<int> found;
+		std::vector<int> expected;
+		auto matchesBruteForce = [&]()
+		{
+			for (int id = 0; id < particles; id++)
+			{
+				Rectangle area = state.getRectangle(id);
+
+				found.clear();
+				quadTree.search(area, found);
+				std::sort(found.begin(), found.end());
+
+				expected.clear();
+				for (int other = 0; other < particles; other++)
+					if (present[other] && CheckCollisionRecs(area, state.getRectangle(other)))
+						expected.push_back(other);
+
+				if (found != expected)
+					return false;
+			}
+			return true;
+		};
+
+		bool identical = true;
+		for (int frame = 0; frame < config.frames && identical; frame++)
+		{
+			ParticleKernels::integrateAndReflect(state, config.deltaT, screenWidth, screenHeight);
+			quadTree.update(state);
+			if (isCheckedFrame(frame))
+				identical = matchesBruteForce();
+		}
+
+		const auto& tree = quadTree.getTree();
+		size_t rootItems = tree.getNode(0).items.size();
+		size_t depth = tree.getDepth();
+		size_t nodeCount = tree.getNodeCount();
+
+		// in modul geometric forma arborelui depinde doar de elemente, deci actualizarea incrementala trebuie sa lase
+		// exact nodurile unui arbore construit de la zero (nodurile golite sunt eliberate)
+		if (variant.splitThreshold == 0)
+		{
+			StaticQuadTreeContainer<ParticleStore> fresh(Rectangle{ 0.f, 0.f, static_cast<float>(screenWidth), static_cast<float>(screenHeight) }, 0, options);
+			for (int id = 0; id < particles; id++)
+				fresh.insert(id, state.getRectangle(id));
+			identical = identical && fresh.getTree().getNodeCount() == nodeCount;
+		}
+
+		// Elimina trei sferturi din particule; in modul adaptiv nodurile ramase aproape goale se unesc
+		for (int id = 0; id < particles && identical; id++)
+		{
+			if (id % 4 == 0)
+				continue;
+
+			present[id] = 0;
+			identical = quadTree.remove(id);
+		}
+		identical = identical && quadTree.size() == static_cast<size_t>((particles + 3) / 4) && matchesBruteForce();
+
+		std::cout << "QuadTree (" << variant.name << ") vs brut, " << particles << " particule, " << config.frames << " cadre + eliminare: "
+			<< (identical ? "identic" : "DIFERIT") << " (" << rootItems << " elemente in radacina, adancime " << depth << ", "
+			<< nodeCount << " noduri, " << tree.getNodeCount() << " dupa eliminare)\n";
+		passed = passed && identical;
+	}
+
+	return passed;
+}
+
+bool Benchmark::validateGrid(int particles)
+{
+	struct Variant
+	{
+		const char* name;
+		GridUpdateMode updateMode;
+		bool autoCellSize;
+		float cellSizePercentile;
+	};
+	const Variant variants[] = {
+		{ "counting sort, celula automata", GridUpdateMode::CountingSort, true, 100.f },
+		{ "incremental, celula automata", GridUpdateMode::Incremental, true, 100.f },
+		{ "counting sort, celula = percentila 50", GridUpdateMode::CountingSort, true, 50.f },
+		{ "counting sort, 50 x 96 celule", GridUpdateMode::CountingSort, false, 100.f },
+	};
+
+	auto candidatePairs = [&](const GridContainer<ParticleStore>& grid)
+	{
+		std::vector<std::pair<int, int>> pairs;
+		for (int id = 0; id < particles; id++)
+			grid.forEachNeighbour(id, [&](int other)
+			{
+				if (id < other)
+					pairs.emplace_back(id, other);
+			});
+		std::sort(pairs.begin(), pairs.end());
+		return pairs;
+	};
+
+	bool passed = true;
+	std::vector<std::vector<std::pair<int, int>>> referencePairs;
+	for (const Variant& variant : variants)
+	{
+		GridOptions options = config.gridOptions;
+		options.updateMode = variant.updateMode;
+		options.autoCellSize = variant.autoCellSize;
+		options.cellSizePercentile = variant.cellSizePercentile;
+
+		ParticleStore state = generateParticles(particles, false);
+
+		// aceeasi retea initiala ca in ParticleManager
+		GridContainer<ParticleStore> grid(50, 96, screenWidth, screenHeight, options);
+		grid.update(state);
+
+		bool identical = true;
+		size_t candidates = 0;
+		size_t overlapping = 0;
+		for (int frame = 0; frame < config.frames && identical; frame++)
+		{
+			// la jumatatea rularii particulele se maresc, iar reteaua automata trebuie sa se redimensioneze
+			if (frame == config.frames / 2)
+				for (int id = 0; id < particles; id++)
+					state.radius[id] *= 1.5f;
+
+			ParticleKernels::integrateAndReflect(state, config.deltaT, screenWidth, screenHeight);
+			grid.update(state);
+
+			auto pairs = candidatePairs(grid);
+
+			// parcurgerea pe jumatate de vecinatate trebuie sa dea aceleasi perechi, fiecare o singura data
+			std::vector<std::pair<int, int>> halfPairs;
+			grid.forEachCandidatePair([&](int first, int second)
+			{
+				halfPairs.emplace_back(std::min(first, second), std::max(first, second));
+			});
+			std::sort(halfPairs.begin(), halfPairs.end());
+			identical = halfPairs == pairs;
+			candidates = halfPairs.size();
+
+			// cu aceleasi celule, cele doua moduri de actualizare trebuie sa propuna aceleasi perechi
+			if (variant.autoCellSize && variant.cellSizePercentile == 100.f)
+			{
+				if (variant.updateMode == GridUpdateMode::CountingSort)
+					referencePairs.push_back(pairs);
+				else
+					identical = frame < (int)referencePairs.size() && pairs == referencePairs[frame];
+			}
+
+			if (isCheckedFrame(frame))
+			{
+				auto overlaps = bruteForcePairs(state, OverlapTest::Circles);
+				overlapping = overlaps.size();
+				identical = identical && std::includes(pairs.begin(), pairs.end(), overlaps.begin(), overlaps.end());
+			}
+		}
+
+		std::cout << "Grid (" << variant.name << ") vs brut, " << particles << " particule, " << config.frames << " cadre: "
+			<< (identical ? "identic" : "DIFERIT") << " (" << grid.getRows() << " x " << grid.getCols() << " celule de "
+			<< grid.getCellWidth() << " x " << grid.getCellHeight() << ", " << grid.getReach() << " inele, "
+			<< candidates << " candidate, " << overlapping << " suprapuneri)\n";
+		passed = passed && identical;
+	}
+
+	return passed;
+}
+
+bool Benchmark::validateSpatialHash(int particles)
+{
+	auto checkFrame = [&](const ParticleStore& state, const SpatialHashContainer<ParticleStore>& hash, size_t& candidates, size_t& overlapping)
+	{
+		std::vector<std::pair<int, int>> pairs;
+		hash.forEachCandidatePair([&](int first, int second)
+		{
+			pairs.emplace_back(std::min(first, second), std::max(first, second));
+		});
+		std::sort(pairs.begin(), pairs.end());
+		candidates = pairs.size();
+
+		// fiecare pereche o singura data, aceleasi perechi ca vecinatatea completa si nicio suprapunere ratata
+		std::vector<std::pair<int, int>> neighbourPairs;
+		for (int id = 0; id < particles; id++)
+			hash.forEachNeighbour(id, [&](int other)
+			{
+				if (id < other)
+					neighbourPairs.emplace_back(id, other);
+			});
+		std::sort(neighbourPairs.begin(), neighbourPairs.end());
+
+		auto overlaps = bruteForcePairs(state, OverlapTest::Circles);
+		overlapping = overlaps.size();
+
+		return pairs == neighbourPairs && std::includes(pairs.begin(), pairs.end(), overlaps.begin(), overlaps.end());
+	};
+
+	bool passed = true;
+
+	// 1. pe ecran, cadru cu cadru
+	{
+		ParticleStore state = generateParticles(particles, false);
+		SpatialHashContainer<ParticleStore> hash(config.gridOptions);
+
+		bool identical = true;
+		size_t candidates = 0;
+		size_t overlapping = 0;
+		for (int frame = 0; frame < config.frames && identical; frame++)
+		{
+			ParticleKernels::integrateAndReflect(state, config.deltaT, screenWidth, screenHeight);
+			hash.update(state);
+			if (isCheckedFrame(frame))
+				identical = checkFrame(state, hash, candidates, overlapping);
+		}
+
+		std::cout << "SpatialHash (ecran) vs brut, " << particles << " particule, " << config.frames << " cadre: "
+			<< (identical ? "identic" : "DIFERIT") << " (" << hash.getCellCount() << " celule ocupate de " << hash.getCellSize() << ", "
+			<< candidates << " candidate, " << overlapping << " suprapuneri)\n";
+		passed = passed && identical;
+	}
+
+	// 2. grupuri de particule intr-o lume de sute de ori mai mare decat ecranul, si la coordonate negative
+	{
+		ParticleStore state = generateParticles(particles, true);
+		for (int id = 0; id < particles; id++)
+		{
+			float cluster = static_cast<float>(id % 7) - 3.f;
+			state.x[id] += cluster * 50.f * screenWidth;
+			state.y[id] -= cluster * 30.f * screenHeight;
+		}
+
+		SpatialHashContainer<ParticleStore> hash(config.gridOptions);
+		hash.update(state);
+
+		size_t candidates = 0;
+		size_t overlapping = 0;
+		bool identical = checkFrame(state, hash, candidates, overlapping);
+
+		std::cout << "SpatialHash (lume fara limite) vs brut, " << particles << " particule: "
+			<< (identical ? "identic" : "DIFERIT") << " (" << hash.getCellCount() << " celule ocupate, tabela de "
+			<< hash.getTableCapacity() << ", " << candidates << " candidate, " << overlapping << " suprapuneri)\n";
+		passed = passed && identical;
+	}
+
+	return passed;
+}
+
+bool Benchmark::validateSweepAndPrune(int particles)
+{
+	bool passed = true;
+
+	for (bool clustered : { false, true })
+	{
+		ParticleStore state = generateParticles(particles, clustered);
+		SweepAndPruneContainer<ParticleStore> sweepAndPrune;
+
+		bool identical = true;
+		size_t candidates = 0;
+		long long swaps = 0;
+		for (int frame = 0; frame < config.frames && identical; frame++)
+		{
+			ParticleKernels::integrateAndReflect(state, config.deltaT, screenWidth, screenHeight);
+			sweepAndPrune.update(state);
+			if (frame > 0)
+				swaps += sweepAndPrune.getLastSwapCount();
+
+			const auto& order = sweepAndPrune.getOrder();
+			for (int i = 1; i < (int)order.size() && identical; i++)
+				identical = sweepAndPrune.getInterval(i - 1).x <= sweepAndPrune.getInterval(i).x;
+
+			if (!isCheckedFrame(frame))
+				continue;
+
+			std::vector<std::pair<int, int>> pairs;
+			sweepAndPrune.forEachCandidatePair([&](int first, int second)
+			{
+				pairs.emplace_back(std::min(first, second), std::max(first, second));
+			});
+			std::sort(pairs.begin(), pairs.end());
+			candidates = pairs.size();
+
+			// aceleasi margini ca in container, cu suprapunerea inclusiva
+			identical = identical && pairs == bruteForcePairs(state, OverlapTest::Boxes);
+		}
+
+		std::cout << "SweepAndPrune (" << (clustered ? "grupate" : "uniforme") << ") vs brut, " << particles << " particule, "
+			<< config.frames << " cadre: " << (identical ? "identic" : "DIFERIT") << " (" << candidates << " candidate, "
+			<< swaps << " deplasari prin insertie dupa primul cadru)\n";
+		passed = passed && identical;
+	}
+
+	// particule regenerate cu acelasi numar, fara reset(): sortarea prin insertie trebuie abandonata pentru std::sort
+	{
+		SweepAndPruneContainer<ParticleStore> sweepAndPrune;
+		sweepAndPrune.update(generateParticles(particles, false));
+		sweepAndPrune.update(generateParticles(particles, true));
+
+		bool sorted = true;
+		for (int i = 1; i < particles && sorted; i++)
+			sorted = sweepAndPrune.getInterval(i - 1).x <= sweepAndPrune.getInterval(i).x;
+
+		std::cout << "SweepAndPrune dupa regenerare, " << particles << " particule: " << (sorted ? "sortat" : "NESORTAT")
+			<< " (" << sweepAndPrune.getLastSwapCount() << " deplasari prin insertie inainte de sortarea completa)\n";
+		passed = passed && sorted;
+	}
+
+	return passed;
+}
+
+bool Benchmark::validateBruteForce(int particles)
+{
+	bool passed = true;
+
+	// 1. fiecare varianta vectoriala da aceleasi perechi, in aceeasi ordine, ca varianta scalara,
+	//    iar varianta scalara contine toate perechile pentru care CheckCollisionCircles este adevarat
+	{
+		ParticleStore state = generateParticles(particles, true);
+
+		std::vector<std::pair<int, int>> reference;
+		ParticleKernels::findOverlappingPairs(state, reference, SimdLevel::Scalar);
+
+		std::vector<std::pair<int, int>> sortedReference = reference;
+		std::sort(sortedReference.begin(), sortedReference.end());
+		auto overlaps = bruteForcePairs(state, OverlapTest::Circles);
+		bool complete = std::includes(sortedReference.begin(), sortedReference.end(), overlaps.begin(), overlaps.end());
+
+		std::cout << "BruteForce Scalar vs CheckCollisionCircles, " << particles << " particule: "
+			<< (complete ? "identic" : "DIFERIT") << " (" << reference.size() << " perechi)\n";
+		passed = passed && complete;
+
+		for (SimdLevel level : { SimdLevel::SSE, SimdLevel::AVX2, SimdLevel::AVX512 })
+		{
+			if (level > ParticleKernels::detectSimdLevel())
+				continue;
+
+			std::vector<std::pair<int, int>> pairs;
+			ParticleKernels::findOverlappingPairs(state, pairs, level);
+
+			bool identical = pairs == reference;
+			std::cout << "BruteForce " << ParticleKernels::simdLevelName(level) << " vs Scalar, " << particles << " particule: "
+				<< (identical ? "identic" : "DIFERIT") << "\n";
+			passed = passed && identical;
+		}
+	}
+
+	// 2. referinta pentru ceilalti algoritmi: pornind din aceeasi stare, fiecare trebuie sa gaseasca exact aceleasi
+	//    coliziuni ca testul pe toate perechile, la fiecare cadru
+	std::vector<std::vector<std::pair<int, int>>> reference;
+	simulate(Algo::BruteForce, particles, &reference);
+	size_t referenceContacts = 0;
+	for (const auto& frame : reference)
+		referenceContacts += frame.size();
+
+	for (Algo algo : { Algo::QuadTree, Algo::Grid, Algo::BoundingVolume, Algo::SweepAndPrune })
+	{
+		std::vector<std::vector<std::pair<int, int>>> contacts;
+		simulate(algo, particles, &contacts);
+
+		bool identical = contacts == reference;
+		std::cout << algoName(algo) << " vs BruteForce (coliziuni), " << particles << " particule, " << config.frames << " cadre: "
+			<< (identical ? "identic" : "DIFERIT") << " (" << referenceContacts << " coliziuni)\n";
+		passed = passed && identical;
+	}
+
+	return passed;
+}
+
+bool Benchmark::validateWorkerCounts(int particles)
+{
+	size_t configuredThreads = pm.getThreadCount();
+	bool passed = true;
+
+	for (Algo algo : { Algo::QuadTree, Algo::Grid, Algo::BoundingVolume, Algo::SweepAndPrune, Algo::BruteForce })
+	{
+		pm.setWorkerCount(0);
+		ParticleStore reference = simulate(algo, particles);
+
+		for (size_t workers : { 1, 3, 7 })
+		{
+			pm.setWorkerCount(workers);
+			ParticleStore candidate = simulate(algo, particles);
+			bool identical = statesEqual(reference, candidate);
+
+			std::cout << algoName(algo) << " cu " << workers + 1 << " fire vs 1 fir, " << particles << " particule, "
+				<< config.frames << " cadre: " << (identical ? "identic" : "DIFERIT") << "\n";
+			passed = passed && identical;
+		}
+	}
+
+	pm.setWorkerCount(configuredThreads - 1);
+	return passed;
+}
+
+bool Benchmark::validateGridColored(int particles)
+{
+	GridOptions colored = config.gridOptions;
+	colored.layout = GridLayout::Dense;
+	colored.solveMode = GridSolveMode::ColoredCells;
+	pm.setGridOptions(colored);
+	size_t configuredThreads = pm.getThreadCount();
+
+	bool passed = true;
+
+	// 1. primul cadru porneste din aceeasi stare ca testul pe toate perechile, deci coliziunile trebuie sa coincida
+	std::vector<std::vector<std::pair<int, int>>> referenceContacts;
+	pm.setWorkerCount(0);
+	ParticleStore reference = simulate(Algo::Grid, particles, &referenceContacts);
+	if (!referenceContacts.empty())
+	{
+		startAlgo(Algo::BruteForce, particles);
+		pm.updateParticles(config.deltaT);
+
+		bool identical = pm.getContacts() == referenceContacts.front();
+		std::cout << "Grid pe culori vs BruteForce (coliziunile primului cadru), " << particles << " particule: "
+			<< (identical ? "identic" : "DIFERIT") << " (" << referenceContacts.front().size() << " coliziuni)\n";
+		passed = passed && identical;
+	}
+
+	// 2. celulele unei culori nu au particule comune, deci rezultatul nu depinde de numarul de fire
+	for (size_t workers : { 1, 3, 7 })
+	{
+		pm.setWorkerCount(workers);
+		ParticleStore candidate = simulate(Algo::Grid, particles);
+		bool identical = statesEqual(reference, candidate);
+
+		std::cout << "Grid pe culori cu " << workers + 1 << " fire vs 1 fir, " << particles << " particule, "
+			<< config.frames << " cadre: " << (identical ? "identic" : "DIFERIT") << "\n";
+		passed = passed && identical;
+	}
+
+	pm.setWorkerCount(configuredThreads - 1);
+	pm.setGridOptions(config.gridOptions);
+	return passed;
+}
+
+void Benchmark::printCrossovers(const std::vector<BenchmarkResult>& results)
+{
+	std::map<int, double> bruteForce;
+	for (const auto& result : results)
+		if (result.algo == Algo::BruteForce)
+			bruteForce[result.particles] = result.median;
+
+	if (bruteForce.empty())
+		return;
+
+	for (Algo algo : config.algorithms)
+	{
+		if (algo == Algo::BruteForce)
+			continue;
+
+		std::map<int, double> medians;
+		for (const auto& result : results)
+			if (result.algo == algo && bruteForce.count(result.particles))
+				medians[result.particles] = result.median;
+
+		if (medians.empty())
+			continue;
+
+		// cel mai mic numar de particule de la care algoritmul ramane mai rapid la toate numerele mai mari
+		int crossover = -1;
+		for (auto it = medians.rbegin(); it != medians.rend() && it->second < bruteForce[it->first]; ++it)
+			crossover = it->first;
+
+		std::cout << algoName(algo) << " vs BruteForce (mediana): ";
+		if (crossover < 0)
+			std::cout << "mai lent pana la " << medians.rbegin()->first << " particule\n";
+		else if (crossover == medians.begin()->first)
+			std::cout << "mai rapid de la cel mai mic numar masurat, " << crossover << " particule\n";
+		else
+			std::cout << "mai rapid de la " << crossover << " particule\n";
+	}
+}
+
+void Benchmark::printBvhStats()
+{
+	std::cout << std::left << std::setw(12) << "Distributie"
+		<< std::setw(10) << "Builder"
+		<< std::right << std::setw(10) << "Particule"
+		<< std::setw(10) << "Cost SAH"
+		<< std::setw(10) << "Adancime"
+		<< std::setw(10) << "Noduri"
+		<< std::setw(10) << "Frunze"
+		<< "  Frunze dupa numarul de Box-uri\n";
+
+	for (int particles : config.particleCounts)
+	{
+		for (bool clustered : { false, true })
+		{
+			ParticleStore state = generateParticles(particles, clustered);
+
+			for (BvhBuilder builder : { BvhBuilder::Midpoint, BvhBuilder::BinnedSah, BvhBuilder::Lbvh })
+			{
+				BvhOptions options = config.bvhOptions;
+				options.builder = builder;
+
+				BvhContainer<ParticleStore> bvh(state, options);
+				bvh.buildBVH();
+				BvhStats stats = bvh.computeStats();
+
+				std::cout << std::left << std::setw(12) << (clustered ? "grupata" : "uniforma")
+					<< std::setw(10) << bvhBuilderName(builder)
+					<< std::right << std::setw(10) << particles
+					<< std::setw(10) << std::fixed << std::setprecision(2) << stats.sahCost << std::defaultfloat
+					<< std::setw(10) << stats.depth
+					<< std::setw(10) << stats.nodeCount
+					<< std::setw(10) << stats.leafCount << " ";
+				for (size_t size = 0; size < stats.leafSizeHistogram.size(); size++)
+					if (stats.leafSizeHistogram[size] > 0)
+						std::cout << " " << size << ":" << stats.leafSizeHistogram[size];
+				std::cout << "\n";
+			}
+		}
+	}
+}
+
+std::string Benchmark::bvhBuilderName(BvhBuilder builder)
+{
+	switch (builder)
+	{
+	case BvhBuilder::Midpoint:
+		return "midpoint";
+	case BvhBuilder::BinnedSah:
+		return "sah";
+	case BvhBuilder::Lbvh:
+		return "lbvh";
+	}
+	return "unknown";
+}
+
+ParticleStore Benchmark::generateParticles(int particles, bool clustered)
+{
+	std::mt19937 generator(config.seed);
+	std::uniform_real_distribution<float> xDistrib(0.f, static_cast<float>(screenWidth));
+	std::uniform_real_distribution<float> yDistrib(0.f, static_cast<float>(screenHeight));
+	std::uniform_real_distribution<float> radiusDistrib(4.1f, 8.9f);
+	std::uniform_real_distribution<float> directionDistrib(-5.f, 5.f);
+
+	// pentru distributia grupata, particulele sunt imprastiate normal in jurul catorva centre
+	std::vector<Vector2> clusterCenters;
+	for (int i = 0; i < 8; i++)
+		clusterCenters.push_back(Vector2{ xDistrib(generator), yDistrib(generator) });
+	std::uniform_int_distribution<int> clusterDistrib(0, static_cast<int>(clusterCenters.size()) - 1);
+	std::normal_distribution<float> spreadDistrib(0.f, 40.f);
+
+	ParticleStore store;
+	for (int i = 0; i < particles; i++)
+	{
+		float x, y;
+		if (clustered)
+		{
+			const Vector2& center = clusterCenters[clusterDistrib(generator)];
+			x = std::min(std::max(center.x + spreadDistrib(generator), 0.f), static_cast<float>(screenWidth));
+			y = std::min(std::max(center.y + spreadDistrib(generator), 0.f), static_cast<float>(screenHeight));
+		}
+		else
+		{
+			x = xDistrib(generator);
+			y = yDistrib(generator);
+		}
+		float radius = radiusDistrib(generator);
+		float vx = directionDistrib(generator);
+		float vy = directionDistrib(generator);
+		store.add(radius, Vector2{ x, y }, Vector2{ vx, vy });
+	}
+
+	return store;
+}
+
+double Benchmark::percentile(const std::vector<double>& sorted, double percentile)
+{
+	if (sorted.empty())
+		return 0.0;
+
+	// metoda rangului cel mai apropiat
+	size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * sorted.size()));
+	if (rank == 0)
+		rank = 1;
+
+	return sorted[std::min(rank, sorted.size()) - 1];
+}
+
+void Benchmark::printResults(const std::vector<BenchmarkResult>& results)
+{
+	std::cout << std::left << std::setw(12) << "Algoritm"
+		<< std::right << std::setw(10) << "Particule"
+		<< std::setw(10) << "Cadre"
+		<< std::setw(12) << "Medie(ms)"
+		<< std::setw(12) << "Mediana"
+		<< std::setw(12) << "p95"
+		<< std::setw(12) << "p99"
+		<< std::setw(12) << "Min"
+		<< std::setw(12) << "Max" << "\n";
+
+	std::cout << std::fixed << std::setprecision(3);
+	for (const auto& result : results)
+	{
+		std::cout << std::left << std::setw(12) << algoName(result.algo)
+			<< std::right << std::setw(10) << result.particles
+			<< std::setw(10) << result.frames
+			<< std::setw(12) << result.mean
+			<< std::setw(12) << result.median
+			<< std::setw(12) << result.p95
+			<< std::setw(12) << result.p99
+			<< std::setw(12) << result.min
+			<< std::setw(12) << result.max << "\n";
+	}
+	std::cout << std::defaultfloat;
+}
+
+void Benchmark::storeToCsv(const std::vector<BenchmarkResult>& results, const std::string& path)
+{
+	std::ofstream file(path, std::ios::out);
+
+	if (!file)
+	{
+		std::cerr << "Failed to open the file." << std::endl;
+		return;
+	}
+
+	file << "Algorithm, Number of Items, Frames, Mean (miliseconds), Median (miliseconds), P95 (miliseconds), P99 (miliseconds), Min (miliseconds), Max (miliseconds), Seed" << std::endl;
+	for (const auto& result : results)
+	{
+		file << algoName(result.algo) << ", " << result.particles << ", " << result.frames << ", "
+			<< result.mean << ", " << result.median << ", " << result.p95 << ", " << result.p99 << ", "
+			<< result.min << ", " << result.max << ", " << config.seed << std::endl;
+	}
+
+	file.close();
+}
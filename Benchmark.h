@@ -0,0 +1,237 @@
+#pragma once
+#include <vector>
+#include <string>
+#include "ParticleManager.h"
+#include "MeasurementCollector.h"
+
+/// \struct BenchmarkConfig
+/// \brief Parametrii unei rulari de benchmark fara fereastra.
+struct BenchmarkConfig
+{
+    std::vector<int> particleCounts{ 1000, 5000, 10000 };   ///< Numerele de particule pentru care se ruleaza benchmark-ul.
+    std::vector<Algo> algorithms{ Algo::QuadTree, Algo::Grid, Algo::BoundingVolume, Algo::SweepAndPrune, Algo::BruteForce }; ///< Algoritmii masurati.
+    int frames = 300;                                        ///< Numarul de cadre masurate pentru fiecare pereche (algoritm, numar de particule).
+    int warmupFrames = 10;                                   ///< Numarul de cadre rulate inainte de masurare.
+    unsigned int seed = 42;                                  ///< Samanta pentru generarea particulelor.
+    float deltaT = 0.15f;                                    ///< Pasul de timp folosit pentru fiecare cadru.
+    std::string csvPath;                                     ///< Fisierul CSV in care se scriu rezultatele (gol = fara CSV).
+    bool validate = false;                                   ///< Ruleaza verificarile de corectitudine in locul masuratorilor.
+    BvhOptions bvhOptions;                                   ///< Parametrii containerului BVH.
+    QuadTreeOptions quadTreeOptions;                         ///< Parametrii containerului QuadTree.
+    GridOptions gridOptions;                                 ///< Parametrii containerului Grid.
+    bool bvhStats = false;                                   ///< Afiseaza calitatea arborelui BVH in locul masuratorilor.
+    int workers = -1;                                        ///< Numarul de fire suplimentare ale ParticleManager (-1 = numarul de nuclee minus unu).
+};
+
+/// \struct BenchmarkResult
+/// \brief Statisticile timpilor pe cadru pentru un algoritm si un numar de particule.
+struct BenchmarkResult
+{
+    Algo algo;            ///< Algoritmul masurat.
+    int particles;        ///< Numarul de particule.
+    int frames;           ///< Numarul de cadre masurate.
+    double mean;          ///< Media timpului pe cadru (milisecunde).
+    double median;        ///< Mediana timpului pe cadru (milisecunde).
+    double p95;           ///< Percentila 95 a timpului pe cadru (milisecunde).
+    double p99;           ///< Percentila 99 a timpului pe cadru (milisecunde).
+    double min;           ///< Cel mai mic timp pe cadru (milisecunde).
+    double max;           ///< Cel mai mare timp pe cadru (milisecunde).
+};
+
+/// \class Benchmark
+/// \brief Ruleaza algoritmii de detectie a coliziunilor fara fereastra raylib si masoara timpul pe cadru.
+///
+/// Pentru fiecare numar de particule si fiecare algoritm, particulele sunt regenerate cu aceeasi samanta,
+/// astfel incat toti algoritmii pornesc din aceeasi stare initiala. Se ruleaza mai multe cadre si se
+/// raporteaza mediana si percentilele 95/99, nu un singur esantion.
+class Benchmark
+{
+public:
+    /// \brief Constructor.
+    /// \param screenWidth Latimea spatiului simulat.
+    /// \param screenHeight Inaltimea spatiului simulat.
+    /// \param config Parametrii benchmark-ului.
+    Benchmark(int screenWidth, int screenHeight, const BenchmarkConfig& config);
+
+    /// \brief Interpreteaza argumentele din linia de comanda.
+    ///
+    /// Argumente acceptate: `--sizes 1000,5000`, `--sweep start:end:step`, `--frames N`, `--warmup N`,
+    /// `--seed N`, `--algos quadtree,grid,bvh,sap,bruteforce`, `--dt valoare`, `--csv fisier`, `--validate`,
+    /// `--bvh-update refit|rebuild`, `--bvh-rebuild-threshold valoare`, `--bvh-builder midpoint|sah|lbvh`, `--bvh-bins N`,
+    /// `--bvh-leaf-size N`, `--bvh-parallel-build on|off`, `--bvh-parallel-threshold N`, `--bvh-stats`,
+    /// `--quadtree-looseness valoare`, `--quadtree-update incremental|rebuild`, `--quadtree-max-depth N`, `--quadtree-split N`, `--quadtree-merge N`,
+    /// `--grid-update counting-sort|incremental`, `--grid-layout dense|hash`, `--grid-cell auto|fixed`, `--grid-cell-percentile p`, `--grid-solve global|colored`, `--workers N`.
+    ///
+    /// \param argc Numarul de argumente.
+    /// \param argv Argumentele.
+    /// \param config Configuratia care se completeaza.
+    /// \return `true` daca argumentele sunt valide, altfel `false`.
+    static bool parseArguments(int argc, char** argv, BenchmarkConfig& config);
+
+    /// \brief Afiseaza modul de utilizare al benchmark-ului.
+    static void printUsage();
+
+    /// \brief Returneaza numele unui algoritm.
+    /// \param algo Algoritmul.
+    /// \return Numele algoritmului.
+    static std::string algoName(Algo algo);
+
+    /// \brief Ruleaza toate combinatiile (algoritm, numar de particule).
+    /// \return Rezultatele pentru fiecare combinatie.
+    std::vector<BenchmarkResult> run();
+
+    /// \brief Ruleaza verificarile de corectitudine si afiseaza rezultatul fiecareia.
+    /// \return `true` daca toate verificarile au trecut, altfel `false`.
+    bool validate();
+
+    /// \brief Verifica faptul ca, dupa fiecare StaticQuadTreeContainer::update, cautarea dupa dreptunghiul fiecarei particule
+    /// gaseste exact particulele ale caror dreptunghiuri se intersecteaza cu el, comparand cu un test brut O(n^2),
+    /// pentru quadtree-ul strict si pentru cel loose, cu impartire geometrica si adaptiva. La final elimina trei sferturi
+    /// din particule si verifica din nou cautarea.
+    /// \param particles Numarul de particule folosit in verificare.
+    /// \return `true` daca rezultatele coincid pentru fiecare particula si fiecare cadru.
+    bool validateQuadTree(int particles);
+
+    /// \brief Verifica faptul ca GridContainer propune ca perechi candidate toate perechile de particule care se suprapun,
+    /// comparand cu un test brut O(n^2), in ambele moduri de actualizare si cu celule automate sau fixe, inclusiv dupa ce
+    /// particulele isi maresc raza; cele doua moduri de actualizare trebuie sa propuna aceleasi perechi, iar parcurgerea
+    /// GridContainer::forEachCandidatePair trebuie sa dea fiecare pereche exact o data.
+    /// \param particles Numarul de particule folosit in verificare.
+    /// \return `true` daca nicio pereche nu lipseste si modurile coincid la fiecare cadru.
+    bool validateGrid(int particles);
+
+    /// \brief Verifica faptul ca SpatialHashContainer propune fiecare pereche de celule vecine o singura data si nu rateaza
+    /// nicio suprapunere, comparand cu un test brut O(n^2), pe ecran si intr-o lume mult mai mare, cu coordonate negative.
+    /// \param particles Numarul de particule folosit in verificare.
+    /// \return `true` daca nicio pereche nu lipseste si nu se repeta.
+    bool validateSpatialHash(int particles);
+
+    /// \brief Verifica faptul ca SweepAndPruneContainer propune exact perechile de particule ale caror dreptunghiuri se
+    /// suprapun, fiecare o singura data, comparand cu un test brut O(n^2) la fiecare cadru, si ca ordinea ramane sortata
+    /// dupa sortarea prin insertie.
+    /// \param particles Numarul de particule folosit in verificare.
+    /// \return `true` daca perechile coincid la fiecare cadru.
+    bool validateSweepAndPrune(int particles);
+
+    /// \brief Verifica testul vectorizat pe toate perechile si il foloseste ca referinta pentru ceilalti algoritmi.
+    ///
+    /// Variantele SSE/AVX2/AVX-512 trebuie sa dea aceleasi perechi ca varianta scalara, iar aceasta sa contina toate
+    /// perechile pentru care CheckCollisionCircles este adevarat. Apoi fiecare algoritm ruleaza simularea din aceeasi
+    /// stare initiala si trebuie sa gaseasca, la fiecare cadru, exact aceleasi coliziuni ca Algo::BruteForce.
+    /// \param particles Numarul de particule folosit in verificare.
+    /// \return `true` daca toate perechile coincid.
+    bool validateBruteForce(int particles);
+
+    /// \brief Verifica faptul ca simularea din ParticleManager da aceeasi stare finala, bit cu bit, cu 1, 2, 4 si 8 fire,
+    /// pentru fiecare algoritm.
+    /// \param particles Numarul de particule folosit in verificare.
+    /// \return `true` daca starile coincid pentru fiecare numar de fire.
+    bool validateWorkerCounts(int particles);
+
+    /// \brief Verifica rezolvarea Grid pe culori de celule (GridSolveMode::ColoredCells): la primul cadru trebuie sa gaseasca
+    /// aceleasi coliziuni ca testul pe toate perechile, iar starea finala trebuie sa fie identica bit cu bit cu 1, 2, 4 si 8 fire.
+    /// \param particles Numarul de particule folosit in verificare.
+    /// \return `true` daca toate rezultatele coincid.
+    bool validateGridColored(int particles);
+
+    /// \brief Afiseaza statisticile de calitate ale BVH (cost SAH, adancime, dimensiunile frunzelor) pentru fiecare builder,
+    /// pe o distributie uniforma si pe una grupata de particule.
+    void printBvhStats();
+
+    /// \brief Afiseaza rezultatele sub forma de tabel.
+    /// \param results Rezultatele de afisat.
+    void printResults(const std::vector<BenchmarkResult>& results);
+
+    /// \brief Afiseaza, pentru fiecare algoritm, numarul de particule de la care mediana timpului pe cadru este mai mica
+    /// decat cea a testului pe toate perechile (Algo::BruteForce) si ramane mai mica pentru toate numerele mai mari.
+    /// Nu afiseaza nimic daca Algo::BruteForce nu a fost masurat.
+    /// \param results Rezultatele de comparat.
+    void printCrossovers(const std::vector<BenchmarkResult>& results);
+
+    /// \brief Scrie rezultatele intr-un fisier CSV.
+    /// \param results Rezultatele de scris.
+    /// \param path Calea fisierului.
+    void storeToCsv(const std::vector<BenchmarkResult>& results, const std::string& path);
+
+private:
+    /// \brief Regenereaza particulele din samanta configurata si porneste un algoritm.
+    /// \param algo Algoritmul.
+    /// \param particles Numarul de particule.
+    void startAlgo(Algo algo, int particles);
+
+    /// \brief Simuleaza config.frames cadre cu un algoritm, pornind din starea data de samanta configurata.
+    ///
+    /// Numarul de fire este cel setat in ParticleManager inainte de apel.
+    /// \param algo Algoritmul.
+    /// \param particles Numarul de particule.
+    /// \param contacts Daca nu este nullptr, primeste coliziunile gasite la fiecare cadru.
+    /// \return Starea particulelor dupa ultimul cadru.
+    ParticleStore simulate(Algo algo, int particles, std::vector<std::vector<std::pair<int, int>>>* contacts = nullptr);
+
+    /// \brief Spune daca la un cadru al unei verificari se ruleaza si referinta bruta, in O(n^2).
+    ///
+    /// Structurile sunt actualizate la fiecare cadru, dar comparatia cu referinta bruta se face doar la primul cadru,
+    /// la cel din mijloc (unde validateGrid mareste particulele), la ultimul si la VALIDATION_CHECKED_FRAMES cadre
+    /// egal distantate intre ele. La rulari scurte sunt verificate toate cadrele.
+    /// \param frame Indicele cadrului, din [0, config.frames).
+    /// \return `true` daca la cadrul dat se face comparatia.
+    bool isCheckedFrame(int frame) const;
+
+    /// \brief Compara bit cu bit pozitiile si directiile a doua stocari de particule.
+    /// \param first Prima stocare.
+    /// \param second A doua stocare.
+    /// \return `true` daca stocarile au acelasi numar de particule si aceleasi pozitii si directii.
+    static bool statesEqual(const ParticleStore& first, const ParticleStore& second);
+
+    /// \brief Ruleaza un singur algoritm pentru un numar de particule.
+    /// \param algo Algoritmul.
+    /// \param particles Numarul de particule.
+    /// \return Statisticile timpului pe cadru.
+    BenchmarkResult runOne(Algo algo, int particles);
+
+    /// \brief Verifica faptul ca fiecare varianta vectoriala a kernelului de integrare da rezultate identice bit cu bit cu varianta scalara.
+    /// \param particles Numarul de particule folosit in verificare.
+    /// \return `true` daca toate variantele suportate de procesor coincid cu varianta scalara.
+    bool validateSimdKernels(int particles);
+
+    /// \brief Verifica faptul ca faza ingusta (CollisionSolver) da acelasi rezultat, bit cu bit, indiferent de
+    /// numarul de fire si de ordinea in care sunt adaugate perechile candidate.
+    /// \param particles Numarul de particule folosit in verificare.
+    /// \return `true` daca toate rularile coincid cu rularea pe un singur fir.
+    bool validateCollisionSolver(int particles);
+
+    /// \brief Verifica faptul ca BvhContainer::detectCollisions gaseste exact perechile de dreptunghiuri care se suprapun,
+    /// fiecare o singura data, comparand cu un test brut O(n^2), in ambele moduri de actualizare.
+    /// \param particles Numarul de particule folosit in verificare.
+    /// \return `true` daca perechile coincid la fiecare cadru.
+    bool validateBvh(int particles);
+
+    /// \brief Verifica faptul ca arborele construit in paralel (cu 2, 4 si 8 fire) este identic cu cel construit serial,
+    /// pentru fiecare builder.
+    /// \param particles Numarul de particule folosit in verificare.
+    /// \return `true` daca nodurile si ordinea Box-urilor coincid.
+    bool validateBvhParallelBuild(int particles);
+
+    /// \brief Returneaza numele unui builder BVH.
+    /// \param builder Builder-ul.
+    /// \return Numele builder-ului.
+    static std::string bvhBuilderName(BvhBuilder builder);
+
+    /// \brief Genereaza particule cu pozitii, raze si directii aleatoare, pornind de la samanta din configuratie.
+    /// \param particles Numarul de particule.
+    /// \param clustered `true` pentru particule grupate in jurul catorva centre, `false` pentru o distributie uniforma.
+    /// \return Stocarea cu particulele generate.
+    ParticleStore generateParticles(int particles, bool clustered);
+
+    /// \brief Calculeaza percentila (metoda rangului cel mai apropiat) dintr-un vector sortat.
+    /// \param sorted Timpii sortati crescator.
+    /// \param percentile Percentila ceruta, intre 0 si 100.
+    /// \return Valoarea percentilei.
+    static double percentile(const std::vector<double>& sorted, double percentile);
+
+    int screenWidth;                            ///< Latimea spatiului simulat.
+    int screenHeight;                           ///< Inaltimea spatiului simulat.
+    BenchmarkConfig config;                     ///< Parametrii benchmark-ului.
+    MeasurementCollector measurementCollector;  ///< Colector pentru masuratorile interne ale ParticleManager.
+    ParticleManager pm;                         ///< Managerul de particule masurat.
+};
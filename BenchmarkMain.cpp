@@ -0,0 +1,40 @@
+#ifdef PARTICLE_BENCHMARK
+#include <iostream>
+#include "Benchmark.h"
+
+#define SCREEN_WIDTH 1920
+#define SCREEN_HEIGHT 900
+
+// Punctul de intrare pentru executabilul de benchmark (compilat cu PARTICLE_BENCHMARK definit).
+// Nu deschide nicio fereastra raylib, ruleaza doar actualizarea particulelor.
+int main(int argc, char** argv)
+{
+	BenchmarkConfig config;
+	if (!Benchmark::parseArguments(argc, argv, config))
+	{
+		Benchmark::printUsage();
+		return 1;
+	}
+
+	Benchmark benchmark(SCREEN_WIDTH, SCREEN_HEIGHT, config);
+
+	if (config.validate)
+		return benchmark.validate() ? 0 : 1;
+
+	if (config.bvhStats)
+	{
+		benchmark.printBvhStats();
+		return 0;
+	}
+
+	auto results = benchmark.run();
+
+	benchmark.printResults(results);
+	benchmark.printCrossovers(results);
+
+	if (!config.csvPath.empty())
+		benchmark.storeToCsv(results, config.csvPath);
+
+	return 0;
+}
+#endif
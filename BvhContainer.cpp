@@ -1,4 +1,37 @@
 #include "BvhContainer.h"
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace
+{
+    // imprastie cei 16 biti de jos pe pozitiile pare
+    uint32_t expandBits(uint32_t value)
+    {
+        value &= 0x0000FFFF;
+        value = (value | (value << 8)) & 0x00FF00FF;
+        value = (value | (value << 4)) & 0x0F0F0F0F;
+        value = (value | (value << 2)) & 0x33333333;
+        value = (value | (value << 1)) & 0x55555555;
+        return value;
+    }
+}
+
+uint32_t mortonCode2D(uint32_t x, uint32_t y)
+{
+    return (expandBits(x) << 1) | expandBits(y);
+}
+
+int countLeadingZeros(uint32_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, value);
+    return 31 - static_cast<int>(index);
+#else
+    return __builtin_clz(value);
+#endif
+}
 
 // Vertex
 Vertex Vertex::operator+(const Vertex& other) const
@@ -3,9 +3,12 @@
 #include <random>
 #include <algorithm>
 #include <vector>
-#include <map>
 #include <utility>
-#include "Particle.h"
+#include <atomic>
+#include <cfloat>
+#include <cstdint>
+#include "raylib.h"
+#include "ThreadPool.h"
 
 /// \struct Vertex
 /// \brief Reprezinta un vector
@@ -63,6 +66,70 @@ struct Node
     bool isLeaf();
 };
 
+/// \brief Intercaleaza bitii a doua coordonate de 16 biti intr-un cod Morton (bitii lui x pe pozitiile impare).
+/// \param x Coordonata x cuantizata.
+/// \param y Coordonata y cuantizata.
+/// \return Codul Morton de 32 de biti.
+uint32_t mortonCode2D(uint32_t x, uint32_t y);
+
+/// \brief Numara bitii 0 de la inceputul unui numar de 32 de biti.
+/// \param value Numarul, diferit de 0.
+/// \return Numarul de biti 0 dinaintea primului bit 1.
+int countLeadingZeros(uint32_t value);
+
+/// \enum BvhUpdateMode
+/// \brief Modul in care BvhContainer isi actualizeaza arborele la fiecare cadru.
+enum class BvhUpdateMode
+{
+    Rebuild, ///< Arborele este reconstruit de la zero la fiecare cadru.
+    Refit    ///< Se actualizeaza doar dreptunghiurile nodurilor; arborele se reconstruieste cand calitatea lui scade prea mult.
+};
+
+/// \enum BvhBuilder
+/// \brief Modul in care BvhContainer alege planul de divizare al unui nod.
+enum class BvhBuilder
+{
+    Midpoint, ///< Mijlocul axei celei mai lungi a nodului.
+    BinnedSah, ///< Planul cu cel mai mic cost SAH dintre marginile unor intervale (bins) egale pe fiecare axa.
+    Lbvh ///< BVH liniar: Box-urile sortate dupa codul Morton al centrului, ierarhia gasita cu metoda Karras.
+};
+
+/// \struct BvhOptions
+/// \brief Parametrii cu care este construit si actualizat un BvhContainer.
+struct BvhOptions
+{
+    BvhUpdateMode updateMode = BvhUpdateMode::Refit; ///< Modul de actualizare la fiecare cadru.
+    float rebuildThreshold = 1.3f; ///< Cresterea relativa a costului SAH (fata de ultima constructie) peste care arborele se reconstruieste in modul Refit.
+    BvhBuilder builder = BvhBuilder::Midpoint; ///< Modul de alegere a planului de divizare.
+    int binCount = 8; ///< Numarul de intervale pe axa pentru BinnedSah (intre 2 si 64).
+    int maxLeafSize = 2; ///< Nodurile cu cel mult atatea Box-uri raman frunze.
+    float traversalCost = 1.f; ///< Costul SAH al vizitarii unui nod intern.
+    float intersectionCost = 1.f; ///< Costul SAH al testarii unui Box.
+    bool parallelBuild = true; ///< Construieste subarborii mari in paralel, daca containerul are un ThreadPool.
+    int parallelBuildThreshold = 4096; ///< Subarborii cu mai putine Box-uri se construiesc serial; pentru Lbvh, dimensiunea bucatilor procesate in paralel.
+};
+
+/// \struct BvhStats
+/// \brief Statistici despre calitatea unui arbore BVH.
+struct BvhStats
+{
+    float sahCost = 0.f; ///< Costul SAH al arborelui, relativ la radacina.
+    int depth = 0; ///< Adancimea maxima (radacina are adancimea 0).
+    int nodeCount = 0; ///< Numarul de noduri folosite.
+    int leafCount = 0; ///< Numarul de frunze.
+    std::vector<int> leafSizeHistogram; ///< leafSizeHistogram[k] este numarul de frunze cu k Box-uri.
+};
+
+/// \struct KarrasNode
+/// \brief Un nod intern al ierarhiei LBVH, asa cum il gaseste metoda Karras.
+struct KarrasNode
+{
+    int first; ///< Primul Box din interval (in ordinea Morton).
+    int last; ///< Ultimul Box din interval.
+    int left; ///< Copilul stang: nod intern daca >= 0, altfel frunza cu Box-ul -left - 1.
+    int right; ///< Copilul drept, codificat la fel.
+};
+
 /// \class BvhContainer
 /// \brief O clasa care are comportamentul unui algoritm BVH.
 ///
@@ -73,17 +140,13 @@ class BvhContainer
 public:
 
     /// \brief Constructor pentru clasa BvhContainer.
-    /// \param particleMap structura de date care contine ID ul Particulei si Particula.  
-    BvhContainer(std::map<int, std::shared_ptr<T>>& particleMap)
+    /// \param particles Stocarea particulelor, indexata dupa ID-ul dens al particulei.
+    /// \param options Parametrii de constructie si actualizare ai arborelui.
+    /// \param threadPool Pool-ul de fire folosit pentru constructia paralela (nullptr = constructie seriala).
+    BvhContainer(const T& particles, const BvhOptions& options = BvhOptions(), ThreadPool* threadPool = nullptr) :
+        options(options), threadPool(threadPool)
     {
-        for (int i = 0; i < particleMap.size(); i++)
-        {
-            float xMin = particleMap[i]->getX() - particleMap[i]->getRadius();
-            float yMin = particleMap[i]->getY() - particleMap[i]->getRadius();
-            float xMax = particleMap[i]->getX() + particleMap[i]->getRadius();
-            float yMax = particleMap[i]->getY() + particleMap[i]->getRadius();
-            boxes.push_back(Box{ particleMap[i]->getId(), Vertex{xMin, yMin}, Vertex{xMax, yMax} });
-        }
+        loadBoxes(particles);
         bvhNode.resize(2 * boxes.size());
     }
 
@@ -142,24 +205,36 @@ public:
     }
 
     /// \brief Divizeaza recursiv structura de date 
+    ///
+    /// Daca group nu este nullptr, copilul stang este construit ca sarcina separata in ThreadPool; copiii cu mai putin de
+    /// `BvhOptions::parallelBuildThreshold` Box-uri se construiesc serial. Nodurile se aloca atomic din nodesUsed.
     /// \param nodeIdx ID-ul nodului.
-    void subdivide(int nodeIdx)
+    /// \param group Grupul sarcinilor de constructie paralela (nullptr = serial).
+    void subdivide(int nodeIdx, ThreadPool::TaskGroup* group = nullptr)
     {
 
         Node& node = bvhNode[nodeIdx];
-        if (node.boxCount <= 2) return;
+        if (node.boxCount <= options.maxLeafSize) return;
 
         // split plane axis and position
-        Vertex extent = node.aabbMax - node.aabbMin;
         int axis = 0;
-        if (extent.y > extent.x)
-            axis = 1;
-
-        int splitPos;
-        if (axis == 0)
-            splitPos = node.aabbMin.x + extent.x / 2;
+        float splitPos;
+        if (options.builder == BvhBuilder::BinnedSah)
+        {
+            if (!findSahSplit(node, axis, splitPos))
+                return;
+        }
         else
-            splitPos = node.aabbMin.y + extent.y / 2;
+        {
+            Vertex extent = node.aabbMax - node.aabbMin;
+            if (extent.y > extent.x)
+                axis = 1;
+
+            if (axis == 0)
+                splitPos = node.aabbMin.x + extent.x / 2;
+            else
+                splitPos = node.aabbMin.y + extent.y / 2;
+        }
         // split the 2 groups in two halves
         int i = node.firstBox;
         int j = i + node.boxCount - 1;
@@ -193,11 +268,13 @@ public:
 
         if (leftCount == 0 || leftCount == node.boxCount) return;
 
-        int leftChildIdx = nodesUsed++;
-        int rightChildIdx = nodesUsed++;
+        int leftChildIdx = nodesUsed.fetch_add(2);
+        int rightChildIdx = leftChildIdx + 1;
         node.leftChild = leftChildIdx;
+        bvhNode[leftChildIdx].leftChild = 0;
         bvhNode[leftChildIdx].firstBox = node.firstBox;
         bvhNode[leftChildIdx].boxCount = leftCount;
+        bvhNode[rightChildIdx].leftChild = 0;
         bvhNode[rightChildIdx].firstBox = i;
         bvhNode[rightChildIdx].boxCount = node.boxCount - leftCount;
 
@@ -206,44 +283,538 @@ public:
         updateNodeBounds(leftChildIdx);
         updateNodeBounds(rightChildIdx);
 
-        subdivide(leftChildIdx);
-        subdivide(rightChildIdx);
+        ThreadPool::TaskGroup* leftGroup = bvhNode[leftChildIdx].boxCount >= options.parallelBuildThreshold ? group : nullptr;
+        ThreadPool::TaskGroup* rightGroup = bvhNode[rightChildIdx].boxCount >= options.parallelBuildThreshold ? group : nullptr;
+
+        if (leftGroup != nullptr)
+            threadPool->submit(*leftGroup, [this, leftChildIdx, leftGroup] { subdivide(leftChildIdx, leftGroup); });
+        else
+            subdivide(leftChildIdx);
+        subdivide(rightChildIdx, rightGroup);
+    }
+
+    /// \brief Cauta planul de divizare cu cel mai mic cost SAH, cu centrele Box-urilor grupate in intervale egale.
+    ///
+    /// Pentru fiecare axa, centrele sunt impartite in `binCount` intervale; costul fiecarei margini dintre intervale este
+    /// `traversalCost + intersectionCost * (nStanga * semiperimetruStanga + nDreapta * semiperimetruDreapta) / semiperimetruNod`.
+    /// \param node Nodul care se divizeaza.
+    /// \param bestAxis Axa gasita (0 = x, 1 = y).
+    /// \param bestPos Pozitia planului pe axa gasita.
+    /// \return `true` daca divizarea este mai ieftina decat pastrarea nodului ca frunza, altfel `false`.
+    bool findSahSplit(const Node& node, int& bestAxis, float& bestPos)
+    {
+        const int maxBinCount = 64;
+        int binCount = std::min(std::max(options.binCount, 2), maxBinCount);
+
+        float binMinX[maxBinCount], binMinY[maxBinCount], binMaxX[maxBinCount], binMaxY[maxBinCount];
+        int binBoxes[maxBinCount];
+        float rightPerimeter[maxBinCount];
+        int rightBoxes[maxBinCount];
+
+        float nodePerimeter = halfPerimeter(node);
+        float bestCost = FLT_MAX;
+
+        for (int axis = 0; axis < 2; axis++)
+        {
+            float centerMin = FLT_MAX;
+            float centerMax = -FLT_MAX;
+            for (int i = node.firstBox; i < node.firstBox + node.boxCount; i++)
+            {
+                float center = axis == 0 ? boxes[i].center().x : boxes[i].center().y;
+                centerMin = std::min(centerMin, center);
+                centerMax = std::max(centerMax, center);
+            }
+            if (centerMin == centerMax)
+                continue;
+
+            for (int b = 0; b < binCount; b++)
+            {
+                binMinX[b] = binMinY[b] = FLT_MAX;
+                binMaxX[b] = binMaxY[b] = -FLT_MAX;
+                binBoxes[b] = 0;
+            }
+
+            float scale = binCount / (centerMax - centerMin);
+            for (int i = node.firstBox; i < node.firstBox + node.boxCount; i++)
+            {
+                Box& box = boxes[i];
+                float center = axis == 0 ? box.center().x : box.center().y;
+                int b = std::min(binCount - 1, static_cast<int>((center - centerMin) * scale));
+                binBoxes[b]++;
+                binMinX[b] = std::min(binMinX[b], box.vertex0.x);
+                binMinY[b] = std::min(binMinY[b], box.vertex0.y);
+                binMaxX[b] = std::max(binMaxX[b], box.vertex1.x);
+                binMaxY[b] = std::max(binMaxY[b], box.vertex1.y);
+            }
+
+            // baleiere de la dreapta: dreptunghiul si numarul de Box-uri din intervalele b+1 .. binCount-1
+            float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+            int count = 0;
+            for (int b = binCount - 1; b > 0; b--)
+            {
+                if (binBoxes[b] > 0)
+                {
+                    count += binBoxes[b];
+                    minX = std::min(minX, binMinX[b]), minY = std::min(minY, binMinY[b]);
+                    maxX = std::max(maxX, binMaxX[b]), maxY = std::max(maxY, binMaxY[b]);
+                }
+                rightBoxes[b - 1] = count;
+                rightPerimeter[b - 1] = count > 0 ? (maxX - minX) + (maxY - minY) : 0.f;
+            }
+
+            // baleiere de la stanga si evaluarea fiecarui plan
+            minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+            count = 0;
+            for (int b = 0; b < binCount - 1; b++)
+            {
+                if (binBoxes[b] > 0)
+                {
+                    count += binBoxes[b];
+                    minX = std::min(minX, binMinX[b]), minY = std::min(minY, binMinY[b]);
+                    maxX = std::max(maxX, binMaxX[b]), maxY = std::max(maxY, binMaxY[b]);
+                }
+                if (count == 0 || rightBoxes[b] == 0)
+                    continue;
+
+                float leftPerimeter = (maxX - minX) + (maxY - minY);
+                float cost = options.traversalCost * nodePerimeter +
+                    options.intersectionCost * (count * leftPerimeter + rightBoxes[b] * rightPerimeter[b]);
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestPos = centerMin + (b + 1) / scale;
+                }
+            }
+        }
+
+        float leafCost = options.intersectionCost * node.boxCount * nodePerimeter;
+        return bestCost < leafCost;
     }
 
     /// \brief Construieste structura de date pentru BVH
     void buildBVH()
     {
+        rootNodeIndex = 0;
+        nodesUsed = 1;
+
+        if (boxes.empty())
+            return;
+
+        if (options.builder == BvhBuilder::Lbvh)
+        {
+            buildLbvh();
+            builtCost = sahCost();
+            rebuildCount++;
+            return;
+        }
+
         Node& root = bvhNode[rootNodeIndex];
         root.leftChild = 0;
         root.firstBox = 0, root.boxCount = boxes.size();
         updateNodeBounds(rootNodeIndex);
-        subdivide(rootNodeIndex);
+
+        if (threadPool != nullptr && options.parallelBuild && root.boxCount >= options.parallelBuildThreshold)
+        {
+            ThreadPool::TaskGroup group;
+            subdivide(rootNodeIndex, &group);
+            threadPool->wait(group);
+
+            // ordinea nodurilor depinde de firele care le-au alocat; se reface ordinea constructiei seriale
+            renumberNodes();
+        }
+        else
+            subdivide(rootNodeIndex);
+
+        builtCost = sahCost();
+        rebuildCount++;
+    }
+
+    /// \brief Construieste un BVH liniar (LBVH) din codurile Morton ale centrelor Box-urilor.
+    ///
+    /// 1. centrele se cuantizeaza pe 16 biti pe axa in dreptunghiul centrelor si se calculeaza codurile Morton;
+    /// 2. Box-urile se sorteaza dupa cod cu radix sort (4 treceri de 8 biti, histograme pe bucati in paralel);
+    /// 3. pentru fiecare nod intern i (n - 1 noduri, independente) se gasesc intervalul si punctul de divizare
+    ///    dupa prefixul comun al codurilor (Karras, 2012); codurile egale se departajeaza dupa index;
+    /// 4. ierarhia se scrie in formatul Node (copii alaturati, copiii dupa parinte), intervalele de cel mult
+    ///    `BvhOptions::maxLeafSize` Box-uri devenind frunze, apoi dreptunghiurile se calculeaza de jos in sus.
+    void buildLbvh()
+    {
+        int n = static_cast<int>(boxes.size());
+        size_t grain = static_cast<size_t>(std::max(options.parallelBuildThreshold, 1));
+
+        // 1. codurile Morton
+        float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+        for (Box& box : boxes)
+        {
+            Vertex center = box.center();
+            minX = std::min(minX, center.x), minY = std::min(minY, center.y);
+            maxX = std::max(maxX, center.x), maxY = std::max(maxY, center.y);
+        }
+        float scaleX = maxX > minX ? 65535.f / (maxX - minX) : 0.f;
+        float scaleY = maxY > minY ? 65535.f / (maxY - minY) : 0.f;
+
+        mortonKeys.resize(n);
+        mortonOrder.resize(n);
+        forEachChunk(n, grain, [&](size_t, size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                Vertex center = boxes[i].center();
+                uint32_t qx = static_cast<uint32_t>(std::min((center.x - minX) * scaleX, 65535.f));
+                uint32_t qy = static_cast<uint32_t>(std::min((center.y - minY) * scaleY, 65535.f));
+                mortonKeys[i] = mortonCode2D(qx, qy);
+                mortonOrder[i] = static_cast<int>(i);
+            }
+        });
+
+        // 2. sortarea
+        radixSortMorton(grain);
+
+        sortedBoxes.resize(n);
+        forEachChunk(n, grain, [&](size_t, size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+                sortedBoxes[i] = boxes[mortonOrder[i]];
+        });
+        std::swap(boxes, sortedBoxes);
+
+        // 3. nodurile interne Karras
+        karrasNodes.resize(n - 1);
+        forEachChunk(karrasNodes.size(), grain, [&](size_t, size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+                karrasNodes[i] = findKarrasNode(static_cast<int>(i), n);
+        });
+
+        // 4. scrierea nodurilor; pe stiva: (nod de iesire, nod intern Karras)
+        Node& root = bvhNode[rootNodeIndex];
+        root.leftChild = 0;
+        root.firstBox = 0;
+        root.boxCount = n;
+
+        nodePairStack.clear();
+        if (n > options.maxLeafSize)
+            nodePairStack.emplace_back(rootNodeIndex, 0);
+
+        while (!nodePairStack.empty())
+        {
+            int nodeIdx = nodePairStack.back().first;
+            KarrasNode source = karrasNodes[nodePairStack.back().second];
+            nodePairStack.pop_back();
+
+            int leftChildIdx = nodesUsed.fetch_add(2);
+            bvhNode[nodeIdx].leftChild = leftChildIdx;
+            bvhNode[nodeIdx].boxCount = 0;
+
+            int children[2] = { source.left, source.right };
+            for (int side = 0; side < 2; side++)
+            {
+                Node& child = bvhNode[leftChildIdx + side];
+                child.leftChild = 0;
+
+                if (children[side] < 0)
+                {
+                    // frunza Karras: un singur Box
+                    child.firstBox = -children[side] - 1;
+                    child.boxCount = 1;
+                    continue;
+                }
+
+                const KarrasNode& internal = karrasNodes[children[side]];
+                child.firstBox = internal.first;
+                child.boxCount = internal.last - internal.first + 1;
+                if (child.boxCount > options.maxLeafSize)
+                    nodePairStack.emplace_back(leftChildIdx + side, children[side]);
+            }
+        }
+
+        updateBoundsBottomUp();
+    }
+
+    /// \brief Gaseste intervalul de Box-uri si copiii nodului intern i al ierarhiei Karras.
+    /// \param i Indexul nodului intern (intre 0 si n - 2).
+    /// \param n Numarul de Box-uri.
+    /// \return Nodul intern.
+    KarrasNode findKarrasNode(int i, int n) const
+    {
+        // lungimea prefixului comun al cheilor i si j; -1 in afara intervalului
+        auto delta = [&](int a, int b)
+        {
+            if (b < 0 || b >= n)
+                return -1;
+            if (mortonKeys[a] == mortonKeys[b])
+                return 32 + countLeadingZeros(static_cast<uint32_t>(a ^ b));
+            return countLeadingZeros(mortonKeys[a] ^ mortonKeys[b]);
+        };
+
+        // directia intervalului
+        int d = delta(i, i + 1) - delta(i, i - 1) >= 0 ? 1 : -1;
+
+        // capatul celalalt al intervalului
+        int deltaMin = delta(i, i - d);
+        int lengthMax = 2;
+        while (delta(i, i + lengthMax * d) > deltaMin)
+            lengthMax *= 2;
+
+        int length = 0;
+        for (int t = lengthMax / 2; t >= 1; t /= 2)
+            if (delta(i, i + (length + t) * d) > deltaMin)
+                length += t;
+        int j = i + length * d;
+
+        // punctul de divizare: ultima pozitie cu prefix comun mai lung decat al intregului interval
+        int deltaNode = delta(i, j);
+        int split = 0;
+        int t = length;
+        do
+        {
+            t = (t + 1) / 2;
+            if (delta(i, i + (split + t) * d) > deltaNode)
+                split += t;
+        } while (t > 1);
+        int gamma = i + split * d + std::min(d, 0);
+
+        KarrasNode node;
+        node.first = std::min(i, j);
+        node.last = std::max(i, j);
+        node.left = node.first == gamma ? -gamma - 1 : gamma;
+        node.right = node.last == gamma + 1 ? -(gamma + 1) - 1 : gamma + 1;
+        return node;
+    }
+
+    /// \brief Sorteaza stabil mortonKeys (impreuna cu mortonOrder) cu radix sort LSD pe 4 cifre de 8 biti.
+    ///
+    /// Pentru fiecare cifra, fiecare bucata de `grain` chei isi numara cifrele in paralel; dupa suma prefix pe cifre
+    /// si bucati, fiecare bucata isi scrie cheile la pozitiile proprii. Rezultatul nu depinde de numarul de fire.
+    /// \param grain Dimensiunea unei bucati.
+    void radixSortMorton(size_t grain)
+    {
+        size_t n = mortonKeys.size();
+        size_t chunks = (n + grain - 1) / grain;
+
+        radixKeys.resize(n);
+        radixOrder.resize(n);
+        radixOffsets.resize(chunks * 256);
+
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            std::fill(radixOffsets.begin(), radixOffsets.end(), 0);
+            forEachChunk(n, grain, [&](size_t chunk, size_t begin, size_t end)
+            {
+                size_t* histogram = &radixOffsets[chunk * 256];
+                for (size_t i = begin; i < end; i++)
+                    histogram[(mortonKeys[i] >> shift) & 0xFF]++;
+            });
+
+            size_t position = 0;
+            for (size_t digit = 0; digit < 256; digit++)
+                for (size_t chunk = 0; chunk < chunks; chunk++)
+                {
+                    size_t count = radixOffsets[chunk * 256 + digit];
+                    radixOffsets[chunk * 256 + digit] = position;
+                    position += count;
+                }
+
+            forEachChunk(n, grain, [&](size_t chunk, size_t begin, size_t end)
+            {
+                size_t* offsets = &radixOffsets[chunk * 256];
+                for (size_t i = begin; i < end; i++)
+                {
+                    size_t target = offsets[(mortonKeys[i] >> shift) & 0xFF]++;
+                    radixKeys[target] = mortonKeys[i];
+                    radixOrder[target] = mortonOrder[i];
+                }
+            });
+
+            std::swap(mortonKeys, radixKeys);
+            std::swap(mortonOrder, radixOrder);
+        }
+    }
+
+    /// \brief Apeleaza body pentru fiecare bucata de cel mult grain elemente din [0, count), in paralel daca
+    /// containerul are un ThreadPool si constructia paralela este activa.
+    /// \param count Numarul de elemente.
+    /// \param grain Dimensiunea unei bucati.
+    /// \param body Functia apelata cu (indexul bucatii, inceputul, sfarsitul).
+    template<typename Body>
+    void forEachChunk(size_t count, size_t grain, const Body& body)
+    {
+        if (threadPool != nullptr && options.parallelBuild)
+        {
+            threadPool->parallelFor(0, count, grain, [&](size_t begin, size_t end) { body(begin / grain, begin, end); });
+            return;
+        }
+
+        for (size_t begin = 0; begin < count; begin += grain)
+            body(begin / grain, begin, std::min(begin + grain, count));
+    }
+
+    /// \brief Renumeroteaza nodurile in ordinea in care le aloca subdivide serial.
+    ///
+    /// subdivide aloca perechea de copii a unui nod, apoi construieste complet subarborele stang si dupa aceea pe cel
+    /// drept; o parcurgere in adancime (stanga inaintea dreptei) care aloca perechile in aceeasi ordine da exact
+    /// numerotarea seriala. Box-urile nu se muta: fiecare nod isi partitioneaza propriul interval, la fel ca serial.
+    void renumberNodes()
+    {
+        renumberedNodes.resize(bvhNode.size());
+        renumberedNodes[rootNodeIndex] = bvhNode[rootNodeIndex];
+        int next = rootNodeIndex + 1;
+
+        nodeStack.clear();
+        nodeStack.push_back(rootNodeIndex);
+        while (!nodeStack.empty())
+        {
+            int nodeIdx = nodeStack.back();
+            nodeStack.pop_back();
+
+            Node& node = renumberedNodes[nodeIdx];
+            if (node.isLeaf())
+                continue;
+
+            int oldLeft = node.leftChild;
+            node.leftChild = next;
+            renumberedNodes[next] = bvhNode[oldLeft];
+            renumberedNodes[next + 1] = bvhNode[oldLeft + 1];
+
+            nodeStack.push_back(next + 1);
+            nodeStack.push_back(next);
+            next += 2;
+        }
+
+        std::swap(bvhNode, renumberedNodes);
     }
 
     /// \brief Updateaza structura de date cu valorile curente pe care le detin Particulele
+    ///
+    /// In modul Refit arborele se pastreaza si se actualizeaza doar dreptunghiurile. Arborele se reconstruieste
+    /// daca s-a schimbat numarul de particule sau daca costul SAH a crescut peste `BvhOptions::rebuildThreshold` ori costul
+    /// de la ultima constructie.
     /// \param deltaT diferenta de timp
-    /// \param particles structura de date care contine particulele.
-    void update(int deltaT, std::map<int, std::shared_ptr<Particle>>& particles)
+    /// \param particles Stocarea particulelor, indexata dupa ID-ul dens al particulei.
+    void update(int deltaT, const T& particles)
     {
-        boxes.clear();
-        for (int i = 0; i < particles.size(); i++)
+        if (options.updateMode == BvhUpdateMode::Refit && particles.size() == boxes.size() && nodesUsed > 1)
         {
-            float xMin = particles[i]->getX() - particles[i]->getRadius();
-            float yMin = particles[i]->getY() - particles[i]->getRadius();
-            float xMax = particles[i]->getX() + particles[i]->getRadius();
-            float yMax = particles[i]->getY() + particles[i]->getRadius();
-            boxes.push_back(Box{ particles[i]->getId(), Vertex{xMin, yMin}, Vertex{xMax, yMax} });
+            refit(particles);
+            if (sahCost() <= builtCost * options.rebuildThreshold)
+                return;
         }
+        else
+            loadBoxes(particles);
 
-        rootNodeIndex = 0;
-        nodesUsed = 1;
-
-        bvhNode.clear();
+        // vectorul de noduri se realoca doar daca s-a schimbat numarul de particule
         bvhNode.resize(2 * boxes.size());
 
         buildBVH();
     }
 
+    /// \brief Actualizeaza dreptunghiurile din frunze si propaga marginile spre radacina, fara a schimba structura arborelui.
+    /// \param particles Stocarea particulelor, indexata dupa ID-ul dens al particulei.
+    void refit(const T& particles)
+    {
+        for (Box& box : boxes)
+        {
+            int i = box.id;
+            box.vertex0 = Vertex{ particles.x[i] - particles.radius[i], particles.y[i] - particles.radius[i] };
+            box.vertex1 = Vertex{ particles.x[i] + particles.radius[i], particles.y[i] + particles.radius[i] };
+        }
+
+        updateBoundsBottomUp();
+    }
+
+    /// \brief Recalculeaza dreptunghiurile tuturor nodurilor: frunzele din Box-uri, nodurile interne din copii.
+    void updateBoundsBottomUp()
+    {
+        // copiii au intotdeauna indici mai mari decat parintele, deci parcurgerea inversa ajunge la parinte dupa copii
+        for (int nodeIdx = nodesUsed - 1; nodeIdx >= 0; nodeIdx--)
+        {
+            Node& node = bvhNode[nodeIdx];
+            if (node.isLeaf())
+                updateNodeBounds(nodeIdx);
+            else
+            {
+                Node& left = bvhNode[node.leftChild];
+                Node& right = bvhNode[node.leftChild + 1];
+                node.aabbMin = Min(left.aabbMin, right.aabbMin);
+                node.aabbMax = Max(left.aabbMax, right.aabbMax);
+            }
+        }
+    }
+
+    /// \brief Calculeaza costul SAH al arborelui, relativ la radacina.
+    ///
+    /// In 2D probabilitatea ca un nod sa fie vizitat este proportionala cu semiperimetrul dreptunghiului sau.
+    /// \return Costul SAH: `BvhOptions::traversalCost` pentru fiecare nod intern si `BvhOptions::intersectionCost` pentru fiecare Box din frunze, ponderate cu semiperimetrul.
+    float sahCost()
+    {
+        if (nodesUsed == 0 || boxes.empty())
+            return 0.f;
+
+        float rootPerimeter = halfPerimeter(bvhNode[rootNodeIndex]);
+        if (rootPerimeter <= 0.f)
+            return 0.f;
+
+        float cost = 0.f;
+        int usedNodes = nodesUsed;
+        for (int nodeIdx = 0; nodeIdx < usedNodes; nodeIdx++)
+        {
+            Node& node = bvhNode[nodeIdx];
+            float weight = halfPerimeter(node) / rootPerimeter;
+            if (node.isLeaf())
+                cost += weight * node.boxCount * options.intersectionCost;
+            else
+                cost += weight * options.traversalCost;
+        }
+
+        return cost;
+    }
+
+    /// \brief Calculeaza statisticile de calitate ale arborelui curent.
+    /// \return Costul SAH, adancimea, numarul de noduri si histograma dimensiunilor frunzelor.
+    BvhStats computeStats()
+    {
+        BvhStats stats;
+        if (boxes.empty())
+            return stats;
+
+        stats.sahCost = sahCost();
+
+        std::vector<std::pair<int, int>> stack{ { rootNodeIndex, 0 } };
+        while (!stack.empty())
+        {
+            int nodeIdx = stack.back().first;
+            int depth = stack.back().second;
+            stack.pop_back();
+
+            Node& node = bvhNode[nodeIdx];
+            stats.nodeCount++;
+            stats.depth = std::max(stats.depth, depth);
+
+            if (node.isLeaf())
+            {
+                stats.leafCount++;
+                if ((int)stats.leafSizeHistogram.size() <= node.boxCount)
+                    stats.leafSizeHistogram.resize(node.boxCount + 1, 0);
+                stats.leafSizeHistogram[node.boxCount]++;
+            }
+            else
+            {
+                stack.emplace_back(node.leftChild, depth + 1);
+                stack.emplace_back(node.leftChild + 1, depth + 1);
+            }
+        }
+
+        return stats;
+    }
+
+    /// \brief Returneaza de cate ori a fost construit arborele de la zero.
+    /// \return Numarul de constructii complete.
+    int getRebuildCount() const
+    {
+        return rebuildCount;
+    }
+
     /// \brief Returneaza o lista cu nodurile din BVH
     /// \return Lista care contine noduri
     std::vector<Node>& getBvhNodes()
@@ -251,6 +822,44 @@ public:
         return bvhNode;
     }
 
+    /// \brief Returneaza numarul de noduri folosite; doar primele getNodesUsed() noduri din getBvhNodes() fac parte din arbore.
+    /// \return Numarul de noduri folosite.
+    int getNodesUsed() const
+    {
+        return nodesUsed;
+    }
+
+    /// \brief Apeleaza visit cu fiecare nod din primele levels niveluri ale arborelui, parcurgand arborele de la radacina.
+    ///
+    /// Refoloseste stiva de traversare, deci nu trebuie apelata in timpul unei traversari sau actualizari.
+    /// \param levels Numarul de niveluri vizitate (1 = doar radacina).
+    /// \param visit Functia apelata cu fiecare nod vizitat.
+    template <typename Visitor>
+    void forEachNode(int levels, Visitor&& visit)
+    {
+        if (boxes.empty() || levels <= 0)
+            return;
+
+        // pe stiva: (nod, nivel)
+        nodePairStack.clear();
+        nodePairStack.emplace_back(rootNodeIndex, 0);
+        while (!nodePairStack.empty())
+        {
+            int nodeIdx = nodePairStack.back().first;
+            int level = nodePairStack.back().second;
+            nodePairStack.pop_back();
+
+            Node& node = bvhNode[nodeIdx];
+            visit(static_cast<const Node&>(node));
+
+            if (!node.isLeaf() && level + 1 < levels)
+            {
+                nodePairStack.emplace_back(node.leftChild + 1, level + 1);
+                nodePairStack.emplace_back(node.leftChild, level + 1);
+            }
+        }
+    }
+
     /// \brief Returneaza o lista cu Box-urile din BVH
    /// \return Lista care contine Box-uri
     std::vector<Box>& getBoxes()
@@ -263,6 +872,7 @@ public:
     {
         boxes.clear();
         bvhNode.clear();
+        nodesUsed = 1;
     }
 
     /// \brief Calculeaza locul ocupat in memorie de structurile de date folosite de algoritm
@@ -296,6 +906,9 @@ public:
     {
         std::vector<std::pair<int, int>> collisions;
 
+        if (boxes.empty())
+            return collisions;
+
         // Traverse the BVH tree recursively
         traverseBVH(rootNodeIndex, collisions);
 
@@ -303,37 +916,107 @@ public:
     }
 
 private:
-    /// \brief Traverseaza arborele binar din BVH de la radacina la frunze
+    /// \brief Reface lista de Box-uri din pozitiile si razele curente ale particulelor
+    /// \param particles Stocarea particulelor.
+    void loadBoxes(const T& particles)
+    {
+        boxes.clear();
+        boxes.reserve(particles.size());
+        for (int i = 0; i < (int)particles.size(); i++)
+        {
+            float xMin = particles.x[i] - particles.radius[i];
+            float yMin = particles.y[i] - particles.radius[i];
+            float xMax = particles.x[i] + particles.radius[i];
+            float yMax = particles.y[i] + particles.radius[i];
+            boxes.push_back(Box{ i, Vertex{xMin, yMin}, Vertex{xMax, yMax} });
+        }
+    }
+
+    /// \brief Calculeaza semiperimetrul dreptunghiului unui nod.
+    /// \param node Nodul.
+    /// \return Latimea plus inaltimea dreptunghiului.
+    float halfPerimeter(const Node& node) const
+    {
+        return (node.aabbMax.x - node.aabbMin.x) + (node.aabbMax.y - node.aabbMin.y);
+    }
+
+    /// \brief Traverseaza arborele binar din BVH si gaseste toate perechile de Box-uri care se suprapun.
+    ///
+    /// Traversarea arbore-contra-arbore foloseste o stiva de perechi de noduri. O pereche (n, n) inseamna coliziunile
+    /// din interiorul subarborelui n: pentru o frunza se testeaza Box-urile intre ele, altfel se adauga (stanga, stanga),
+    /// (dreapta, dreapta) si (stanga, dreapta). O pereche (a, b) cu a != b este ignorata daca dreptunghiurile nodurilor
+    /// nu se suprapun; daca ambele sunt frunze se testeaza Box-urile lor, altfel se coboara in nodul mai mare.
+    /// Fiecare Box apartine unei singure frunze, deci fiecare pereche care se suprapune este raportata exact o data.
     /// \param nodeIdx ID-ul nodului
     /// \param collisions Lista care contine perechi de obiecte care sunt in coliziune
     void traverseBVH(int nodeIdx, std::vector<std::pair<int, int>>& collisions)
     {
-        Node& node = bvhNode[nodeIdx];
+        nodePairStack.clear();
+        nodePairStack.emplace_back(nodeIdx, nodeIdx);
 
-        if (node.isLeaf())
+        while (!nodePairStack.empty())
         {
-            // Leaf node, check for collisions between boxes
-            int boxStartIdx = node.firstBox;
-            int boxEndIdx = boxStartIdx + node.boxCount - 1;
+            int a = nodePairStack.back().first;
+            int b = nodePairStack.back().second;
+            nodePairStack.pop_back();
+
+            Node& nodeA = bvhNode[a];
+            Node& nodeB = bvhNode[b];
 
-            for (int i = boxStartIdx; i < boxEndIdx; ++i)
+            if (a == b)
             {
-                for (int j = i + 1; j <= boxEndIdx; ++j)
+                if (nodeA.isLeaf())
                 {
-                    if (areBoxesColliding(boxes[i], boxes[j]))
-                    {
-                        // Collision detected, store the box pair
-                        collisions.push_back(std::make_pair(boxes[i].id, boxes[j].id));
-                    }
+                    // Leaf node, check for collisions between boxes
+                    int boxStartIdx = nodeA.firstBox;
+                    int boxEndIdx = boxStartIdx + nodeA.boxCount - 1;
+
+                    for (int i = boxStartIdx; i < boxEndIdx; ++i)
+                        for (int j = i + 1; j <= boxEndIdx; ++j)
+                            if (areBoxesColliding(boxes[i], boxes[j]))
+                                collisions.push_back(std::make_pair(boxes[i].id, boxes[j].id));
                 }
+                else
+                {
+                    nodePairStack.emplace_back(nodeA.leftChild, nodeA.leftChild + 1);
+                    nodePairStack.emplace_back(nodeA.leftChild + 1, nodeA.leftChild + 1);
+                    nodePairStack.emplace_back(nodeA.leftChild, nodeA.leftChild);
+                }
+                continue;
+            }
+
+            if (!areNodesColliding(nodeA, nodeB))
+                continue;
+
+            if (nodeA.isLeaf() && nodeB.isLeaf())
+            {
+                for (int i = nodeA.firstBox; i < nodeA.firstBox + nodeA.boxCount; ++i)
+                    for (int j = nodeB.firstBox; j < nodeB.firstBox + nodeB.boxCount; ++j)
+                        if (areBoxesColliding(boxes[i], boxes[j]))
+                            collisions.push_back(std::make_pair(boxes[i].id, boxes[j].id));
+            }
+            else if (nodeB.isLeaf() || (!nodeA.isLeaf() && halfPerimeter(nodeA) >= halfPerimeter(nodeB)))
+            {
+                // descend the larger node first
+                nodePairStack.emplace_back(nodeA.leftChild + 1, b);
+                nodePairStack.emplace_back(nodeA.leftChild, b);
+            }
+            else
+            {
+                nodePairStack.emplace_back(a, nodeB.leftChild + 1);
+                nodePairStack.emplace_back(a, nodeB.leftChild);
             }
         }
-        else
-        {
-            // Internal node, recursively traverse child nodes
-            traverseBVH(node.leftChild, collisions);
-            traverseBVH(node.leftChild + 1, collisions);
-        }
+    }
+
+    /// \brief Verifica daca dreptunghiurile a doua noduri se suprapun
+    /// \param nodeA Primul nod
+    /// \param nodeB Al doilea nod
+    /// \return 'true' daca nodurile se suprapun altfel 'false'
+    bool areNodesColliding(const Node& nodeA, const Node& nodeB) const
+    {
+        return nodeA.aabbMin.x <= nodeB.aabbMax.x && nodeA.aabbMax.x >= nodeB.aabbMin.x &&
+            nodeA.aabbMin.y <= nodeB.aabbMax.y && nodeA.aabbMax.y >= nodeB.aabbMin.y;
     }
 
     /// \brief Verifica daca doua Box-uri sunt in coliziune una cu alta
@@ -358,5 +1041,19 @@ private:
     std::vector<Box> boxes; ///< Lista de dreptunghiuri/Box-uri.
     std::vector<Node> bvhNode; ///< Lista a nodurilor din BVH.
     int rootNodeIndex = 0; ///< Indexul nodului radacina din BVH.
-    int nodesUsed = 1; ///< Numarul de noduri folosite in BVH.
+    std::atomic<int> nodesUsed{ 1 }; ///< Numarul de noduri folosite in BVH.
+    BvhOptions options; ///< Parametrii de constructie si actualizare.
+    std::vector<std::pair<int, int>> nodePairStack; ///< Stiva de perechi de noduri folosita la traversare, pastrata intre cadre.
+    ThreadPool* threadPool; ///< Pool-ul de fire pentru constructia paralela (poate fi nullptr).
+    std::vector<Node> renumberedNodes; ///< Nodurile renumerotate dupa constructia paralela, pastrate intre cadre.
+    std::vector<int> nodeStack; ///< Stiva folosita la renumerotare.
+    std::vector<uint32_t> mortonKeys; ///< Codurile Morton ale Box-urilor (LBVH).
+    std::vector<int> mortonOrder; ///< Indexul Box-ului pentru fiecare cod, permutat odata cu codurile (LBVH).
+    std::vector<uint32_t> radixKeys; ///< Tampon pentru radix sort.
+    std::vector<int> radixOrder; ///< Tampon pentru radix sort.
+    std::vector<size_t> radixOffsets; ///< Histogramele si apoi pozitiile de scriere, cate 256 pentru fiecare bucata.
+    std::vector<Box> sortedBoxes; ///< Box-urile in ordinea Morton, inainte de schimbul cu boxes.
+    std::vector<KarrasNode> karrasNodes; ///< Nodurile interne ale ierarhiei Karras (n - 1).
+    float builtCost = 0.f; ///< Costul SAH la ultima constructie completa.
+    int rebuildCount = 0; ///< Numarul de constructii complete.
 };
\ No newline at end of file
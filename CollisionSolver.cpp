@@ -0,0 +1,149 @@
+#include "CollisionSolver.h"
+#include <algorithm>
+
+CollisionSolver::CollisionSolver(ThreadPool& threadPool) : threadPool(threadPool)
+{
+}
+
+void CollisionSolver::clear()
+{
+	candidates.clear();
+}
+
+void CollisionSolver::addCandidate(int first, int second)
+{
+	if (first == second)
+		return;
+
+	if (first < second)
+		candidates.emplace_back(first, second);
+	else
+		candidates.emplace_back(second, first);
+}
+
+void CollisionSolver::solve(ParticleStore& particles)
+{
+	// 1. testul exact intre cercuri, in paralel
+	overlaps.resize(candidates.size());
+	threadPool.parallelFor(0, candidates.size(), 4096, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			int first = candidates[i].first;
+			int second = candidates[i].second;
+			overlaps[i] = CheckCollisionCircles(particles.getPosition(first), particles.radius[first], particles.getPosition(second), particles.radius[second]);
+		}
+	});
+
+	// 2. ordinea canonica a perechilor in coliziune
+	contacts.clear();
+	for (size_t i = 0; i < candidates.size(); i++)
+		if (overlaps[i])
+			contacts.push_back(candidates[i]);
+
+	std::sort(contacts.begin(), contacts.end());
+	contacts.erase(std::unique(contacts.begin(), contacts.end()), contacts.end());
+
+	// 3. variatia directiilor pentru fiecare pereche, calculata din starea de la inceputul pasului
+	deltaFirst.resize(contacts.size());
+	deltaSecond.resize(contacts.size());
+	threadPool.parallelFor(0, contacts.size(), 1024, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			int first = contacts[i].first;
+			int second = contacts[i].second;
+
+			Vector2 newFirst, newSecond;
+			particles.elasticCollisionResponse(first, second, newFirst, newSecond);
+
+			deltaFirst[i] = Vector2{ newFirst.x - particles.vx[first], newFirst.y - particles.vy[first] };
+			deltaSecond[i] = Vector2{ newSecond.x - particles.vx[second], newSecond.y - particles.vy[second] };
+		}
+	});
+
+	// 4. lista perechilor fiecarei particule (CSR), in ordinea perechilor
+	int particleCount = static_cast<int>(particles.size());
+	contactStart.assign(particleCount + 1, 0);
+	for (const auto& contact : contacts)
+	{
+		contactStart[contact.first + 1]++;
+		contactStart[contact.second + 1]++;
+	}
+	for (int i = 0; i < particleCount; i++)
+		contactStart[i + 1] += contactStart[i];
+
+	contactEntries.resize(contacts.size() * 2);
+	contactFill.assign(contactStart.begin(), contactStart.end() - 1);
+	for (int i = 0; i < (int)contacts.size(); i++)
+	{
+		contactEntries[contactFill[contacts[i].first]++] = 2 * i;
+		contactEntries[contactFill[contacts[i].second]++] = 2 * i + 1;
+	}
+
+	// 5. ponderea fiecarei perechi. Variatiile sunt calculate toate din aceeasi stare, deci suma lor supraestimeaza
+	// impulsul unei particule aflate in mai multe contacte si simularea castiga energie. Ambele variatii ale unei perechi
+	// se inmultesc cu 1 / max(contactele primei particule, contactele celei de-a doua), deci impulsul perechii ramane
+	// conservat; pentru o pereche izolata ponderea este 1.
+	threadPool.parallelFor(0, contacts.size(), 4096, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			int first = contacts[i].first;
+			int second = contacts[i].second;
+			int firstCount = contactStart[first + 1] - contactStart[first];
+			int secondCount = contactStart[second + 1] - contactStart[second];
+			float weight = 1.f / static_cast<float>(std::max(firstCount, secondCount));
+
+			deltaFirst[i] = Vector2{ deltaFirst[i].x * weight, deltaFirst[i].y * weight };
+			deltaSecond[i] = Vector2{ deltaSecond[i].x * weight, deltaSecond[i].y * weight };
+		}
+	});
+
+	// 6. reducerea: fiecare particula isi insumeaza variatiile ponderate in aceeasi ordine, indiferent de fire
+	threadPool.parallelFor(0, particleCount, 4096, [&](size_t begin, size_t end)
+	{
+		for (size_t id = begin; id < end; id++)
+		{
+			if (contactStart[id] == contactStart[id + 1])
+				continue;
+
+			float sumX = 0.f;
+			float sumY = 0.f;
+			for (int entry = contactStart[id]; entry < contactStart[id + 1]; entry++)
+			{
+				int contact = contactEntries[entry] >> 1;
+				const Vector2& delta = (contactEntries[entry] & 1) ? deltaSecond[contact] : deltaFirst[contact];
+				sumX += delta.x;
+				sumY += delta.y;
+			}
+
+			particles.vx[id] += sumX;
+			particles.vy[id] += sumY;
+		}
+	});
+}
+
+const std::vector<std::pair<int, int>>& CollisionSolver::getContacts() const
+{
+	return contacts;
+}
+
+size_t CollisionSolver::getCandidateCount() const
+{
+	return candidates.size();
+}
+
+size_t CollisionSolver::sizeOfDataStructure() const
+{
+	size_t count = 0;
+	count += candidates.capacity() * sizeof(std::pair<int, int>);
+	count += overlaps.capacity() * sizeof(unsigned char);
+	count += contacts.capacity() * sizeof(std::pair<int, int>);
+	count += deltaFirst.capacity() * sizeof(Vector2);
+	count += deltaSecond.capacity() * sizeof(Vector2);
+	count += contactStart.capacity() * sizeof(int);
+	count += contactEntries.capacity() * sizeof(int);
+	count += contactFill.capacity() * sizeof(int);
+	return count;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include "raylib.h"
+#include "ParticleStore.h"
+#include "ThreadPool.h"
+
+/**
+ * \class CollisionSolver
+ * \brief Faza ingusta (narrow phase) paralela si determinista pentru coliziunile dintre particule.
+ *
+ * Algoritmii de impartire spatiala (QuadTree, Grid, BVH) adauga doar perechi candidate. Rezolvarea are loc in pasi:
+ * 1. perechile se normalizeaza (ID mai mic primul) si se testeaza in paralel daca cercurile se intersecteaza;
+ * 2. perechile in coliziune se sorteaza si se elimina duplicatele, deci ordinea nu depinde de algoritmul
+ *    care le-a gasit si nici de numarul de fire;
+ * 3. pentru fiecare pereche se calculeaza in paralel variatia directiilor ambelor particule, pornind de la
+ *    directiile de la inceputul pasului (nimic nu se modifica pe loc);
+ * 4. ambele variatii ale unei perechi se inmultesc cu aceeasi pondere, 1 / max(numarul de perechi al fiecarei
+ *    particule), deci impulsul se conserva, iar o particula aflata in mai multe contacte nu primeste un impuls prea mare;
+ * 5. variatiile ponderate se insumeaza pentru fiecare particula in ordinea perechilor si se aplica.
+ * Rezultatul este identic bit cu bit indiferent de numarul de fire.
+ */
+class CollisionSolver
+{
+public:
+    /**
+     * \brief Constructor.
+     * \param threadPool Pool-ul de fire folosit pentru pasii paraleli.
+     */
+    CollisionSolver(ThreadPool& threadPool);
+
+    /**
+     * \brief Goleste lista de perechi candidate.
+     */
+    void clear();
+
+    /**
+     * \brief Adauga o pereche candidata. Perechile (a, a) sunt ignorate, iar (a, b) si (b, a) sunt aceeasi pereche.
+     * \param first ID-ul primei particule.
+     * \param second ID-ul celei de-a doua particule.
+     */
+    void addCandidate(int first, int second);
+
+    /**
+     * \brief Rezolva toate coliziunile dintre perechile candidate si actualizeaza directiile particulelor.
+     * \param particles Stocarea particulelor.
+     */
+    void solve(ParticleStore& particles);
+
+    /**
+     * \brief Returneaza perechile in coliziune gasite la ultimul apel solve, sortate si fara duplicate.
+     * \return Perechile in coliziune.
+     */
+    const std::vector<std::pair<int, int>>& getContacts() const;
+
+    /**
+     * \brief Returneaza numarul de perechi candidate adaugate de la ultimul clear.
+     * \return Numarul de perechi candidate.
+     */
+    size_t getCandidateCount() const;
+
+    /**
+     * \brief Calculeaza locul ocupat in memorie de structurile de date ale fazei inguste.
+     * \return Numarul de bytes.
+     */
+    size_t sizeOfDataStructure() const;
+
+private:
+    ThreadPool& threadPool;                              ///< Pool-ul de fire.
+    std::vector<std::pair<int, int>> candidates;         ///< Perechile candidate, normalizate.
+    std::vector<unsigned char> overlaps;                 ///< 1 daca perechea candidata este in coliziune.
+    std::vector<std::pair<int, int>> contacts;           ///< Perechile in coliziune, sortate si fara duplicate.
+    std::vector<Vector2> deltaFirst;                     ///< Variatia directiei primei particule din fiecare pereche.
+    std::vector<Vector2> deltaSecond;                    ///< Variatia directiei celei de-a doua particule din fiecare pereche.
+    std::vector<int> contactStart;                       ///< Pentru fiecare particula, inceputul listei sale in contactEntries.
+    std::vector<int> contactEntries;                     ///< Pentru fiecare particula, intrarile (2 * pereche + latura), in ordinea perechilor.
+    std::vector<int> contactFill;                        ///< Pozitia de scriere curenta pentru fiecare particula la construirea contactEntries.
+};
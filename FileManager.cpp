@@ -30,6 +30,12 @@ void FileManager::storeToFile(MeasurementCollector& measureCollector)
         file << pair.first << ", " << pair.second.first << ", " << pair.second.second << ", " << space << std::endl;
     }
 
+    file << std::endl << "Parameter Name, Number of Items, Value" << std::endl;
+    for (const auto& pair : measureCollector.getParameters())
+    {
+        file << pair.first << ", " << pair.second.first << ", " << pair.second.second << std::endl;
+    }
+
     /*  for (const auto& pair : measureCollector.getSizes())
       {
           file << pair.first << ", " << pair.second.first << ", " << pair.second.second << std::endl;
@@ -1,8 +1,9 @@
 #pragma once
 #include<vector>
-#include<map>
 #include<array>
 #include<iostream>
+#include<algorithm>
+#include<cmath>
 
 
 /// \struct Cell
@@ -12,8 +13,88 @@ struct Cell
     std::vector<int> itemIds; ///< Lista de identificatori de elemente.
 };
 
+/// \enum GridUpdateMode
+/// \brief Modul in care GridContainer::update actualizeaza reteaua la fiecare cadru.
+enum class GridUpdateMode
+{
+    Incremental,  ///< Fiecare celula are propriul vector; particulele care schimba celula sunt mutate dintr-un vector in altul.
+    CountingSort  ///< Reteaua se reconstruieste la fiecare cadru, printr-o sortare prin numarare, intr-un singur vector contiguu.
+};
+
+/// \enum GridLayout
+/// \brief Structura de date folosita de algoritmul Grid.
+enum class GridLayout
+{
+    Dense,     ///< Retea de rows x cols celule care acopera ecranul (GridContainer).
+    SparseHash ///< Doar celulele ocupate, intr-o tabela de dispersie, fara limite ale lumii (SpatialHashContainer).
+};
+
+/// \enum GridSolveMode
+/// \brief Modul in care algoritmul Grid rezolva coliziunile gasite in retea.
+enum class GridSolveMode
+{
+    Global,       ///< Perechile candidate merg la CollisionSolver, care aplica media variatiilor calculate din starea de la inceputul pasului.
+    ColoredCells  ///< Celulele sunt colorate astfel incat celulele de aceeasi culoare nu au particule comune; culorile se rezolva pe rand, celulele unei culori in paralel, iar fiecare coliziune se aplica imediat.
+};
+
+/// \struct GridOptions
+/// \brief Parametrii unui GridContainer.
+struct GridOptions
+{
+    GridUpdateMode updateMode = GridUpdateMode::CountingSort; ///< Modul de actualizare intre cadre.
+    GridLayout layout = GridLayout::Dense; ///< Reteaua densa (GridContainer) sau tabela de dispersie (SpatialHashContainer).
+    bool autoCellSize = true;        ///< Dimensiunea celulelor este aleasa din diametrele particulelor (altfel se pastreaza randurile si coloanele din constructor).
+    float cellSizePercentile = 100.f; ///< Percentila diametrelor folosita ca dimensiune a celulei (100 = diametrul maxim).
+    GridSolveMode solveMode = GridSolveMode::Global; ///< Rezolvarea globala sau pe culori de celule (doar pentru GridLayout::Dense).
+};
+
+/// \brief Calculeaza cea mai mare raza a particulelor.
+/// \param particles Stocarea particulelor.
+/// \return Raza maxima (0 daca nu exista particule).
+template <typename T>
+float maxParticleRadius(const T& particles)
+{
+    float largest = 0.f;
+    for (int id = 0; id < (int)particles.size(); id++)
+        largest = std::max(largest, particles.radius[id]);
+
+    return largest;
+}
+
+/// \brief Calculeaza o percentila a diametrelor particulelor.
+/// \param particles Stocarea particulelor.
+/// \param percentile Percentila ceruta, intre 0 si 100 (100 = diametrul maxim).
+/// \param diameters Vector de lucru, refolosit intre apeluri.
+/// \return Diametrul (0 daca nu exista particule).
+template <typename T>
+float diameterPercentile(const T& particles, float percentile, std::vector<float>& diameters)
+{
+    int particleCount = (int)particles.size();
+    if (particleCount == 0)
+        return 0.f;
+
+    diameters.resize(particleCount);
+    for (int id = 0; id < particleCount; id++)
+        diameters[id] = 2.f * particles.radius[id];
+
+    percentile = std::min(std::max(percentile, 0.f), 100.f);
+    size_t rank = static_cast<size_t>(std::ceil(percentile / 100.f * particleCount));
+    rank = rank > 0 ? rank - 1 : 0;
+    std::nth_element(diameters.begin(), diameters.begin() + rank, diameters.end());
+
+    return diameters[rank];
+}
+
 /// \class GridContainer
 /// \brief Reprezinta un container bazat pe o retea pentru impartirea spatiala a elementelor.
+///
+/// In modul GridUpdateMode::CountingSort ID-urile tuturor elementelor stau intr-un singur vector (cellItems), sortat dupa
+/// celula, iar cellStart[c] este pozitia primului element din celula c. Reconstructia este O(n), fara alocari dupa
+/// primul cadru, iar celulele vecine de pe acelasi rand ocupa un interval contiguu din cellItems.
+///
+/// Cu GridOptions::autoCellSize latura celulei este percentila cellSizePercentile a diametrelor particulelor, iar reteaua
+/// se redimensioneaza cand raza maxima se schimba. Cautarea acopera atatea inele de celule vecine cate sunt necesare ca
+/// cel mai mare diametru sa incapa (de obicei unul, adica vecinatatea 3x3), deci nicio coliziune nu este ratata.
 /// \tparam T Tipul elementelor de stocat in retea.
 template <typename T>
 class GridContainer
@@ -24,45 +105,77 @@ public:
     /// \param cols Numarul de coloane in retea.
     /// \param screenWidth Latimea ecranului.
     /// \param screenHeight Inaltimea ecranului.
-    GridContainer(int rows, int cols, int screenWidth, int screenHeight) : rows(rows), cols(cols)
+    /// \param options Parametrii retelei.
+    GridContainer(int rows, int cols, int screenWidth, int screenHeight, const GridOptions& options = GridOptions()) :
+        screenWidth(screenWidth), screenHeight(screenHeight), options(options)
+    {
+        setDimensions(rows, cols);
+    }
+
+    /// \brief Schimba numarul de randuri si coloane si goleste reteaua.
+    /// \param newRows Numarul de randuri.
+    /// \param newCols Numarul de coloane.
+    void setDimensions(int newRows, int newCols)
     {
-        cellWidth = screenWidth / cols;
-        cellHeight = screenHeight / rows;
+        rows = newRows;
+        cols = newCols;
+        cellWidth = static_cast<float>(screenWidth) / cols;
+        cellHeight = static_cast<float>(screenHeight) / rows;
+
+        for (auto& cell : grid)
+            cell.itemIds.clear();
         grid.resize(rows * cols);
+        std::fill(idToIndex.begin(), idToIndex.end(), -1);
+        cellStart.clear();
+    }
+
+    /// \brief Alege dimensiunea celulelor din distributia diametrelor particulelor.
+    ///
+    /// Latura celulei este percentila GridOptions::cellSizePercentile a diametrelor; numarul de celule este limitat la
+    /// de opt ori numarul de particule (dar cel putin 4096), ca particulele foarte mici sa nu produca o retea uriasa.
+    /// \param particles Stocarea particulelor.
+    void tune(const T& particles)
+    {
+        int particleCount = (int)particles.size();
+        tunedMaxRadius = maxParticleRadius(particles);
+        if (particleCount == 0)
+            return;
+
+        float cellSize = std::max(diameterPercentile(particles, options.cellSizePercentile, diameters), 1.f);
+
+        int newCols = std::max(1, static_cast<int>(screenWidth / cellSize));
+        int newRows = std::max(1, static_cast<int>(screenHeight / cellSize));
+
+        double maxCells = std::max(4096.0, 8.0 * particleCount);
+        double cells = static_cast<double>(newRows) * newCols;
+        if (cells > maxCells)
+        {
+            double scale = std::sqrt(cells / maxCells);
+            newCols = std::max(1, static_cast<int>(newCols / scale));
+            newRows = std::max(1, static_cast<int>(newRows / scale));
+        }
+
+        if (newRows != rows || newCols != cols)
+            setDimensions(newRows, newCols);
     }
 
     /// \brief Insereaza un element cu un identificator si coordonatele centrului specificate in celula corespunzatoare din retea.
+    ///
+    /// Folosit in modul GridUpdateMode::Incremental; in modul GridUpdateMode::CountingSort reteaua se construieste cu update().
     /// \param id Identificatorul elementului de inserat.
     /// \param centerX Coordonata X a centrului elementului.
     /// \param centerY Coordonata Y a centrului elementului.
     void insert(int id, float centerX, float centerY)
     {
-        // calculeaza indexul
-        int bigY = (int)(centerY / cellHeight);
-        int bigX = (int)(centerX / cellWidth);
-        long index = bigY * cols + bigX;
-
-        if (index < 0 || index >= grid.size())
-        {
-            std::cout << "index in afara domeniului\n";
-            std::cout << "index = " << index << "\n";
-            std::cout << "X = " << centerX << " , Y = " << centerY << "\n";
-            std::cout << "cols = " << cols << " , rows = " << rows << "\n";
-            std::cout << "cellhight = " << cellHeight << " cellWitdh = " << cellWidth << "\n";
-            std::cout << "(centerY / cellHeight) = " << bigY << "\n";
-            std::cout << "(centerY / cellHeight) * cols = " << bigX * cols << "\n";
-            std::cout << "(centerX / cellWidth) = " << bigX << "\n";
-            std::cout << "((centerY / cellHeight) * cols + (centerX / cellWidth)) = " << ((centerY / cellHeight) * cols + (centerX / cellWidth)) << "\n";
-            std::cout << "((centerY / cellHeight) * cols + (centerX / cellWidth)) - 2.f = " << ((centerY / cellHeight) * cols + (centerX / cellWidth)) - 2.f << "\n";
-
-            return;
-        }
+        int index = cellIndex(centerX, centerY);
 
         // adauga id-ul la pozitia corecta in vector
         grid[index].itemIds.push_back(id);
 
         // adauga in mapare perechea id-index
-        idToIndexMap[id] = index;
+        if (id >= (int)idToIndex.size())
+            idToIndex.resize(id + 1, -1);
+        idToIndex[id] = index;
     }
 
     /// \brief Elimina elementul cu identificatorul specificat din retea.
@@ -70,10 +183,12 @@ public:
     void remove(int id)
     {
         // gaseste indexul la care se afla id-ul
-        int index = idToIndexMap[id];
+        int index = id < (int)idToIndex.size() ? idToIndex[id] : -1;
+        if (index < 0)
+            return;
 
         // sterge elementul din mapare
-        idToIndexMap.erase(id);
+        idToIndex[id] = -1;
 
         // indexul de la care se va elimina id-ul
         int delIndex = -1;
@@ -96,65 +211,211 @@ public:
         }
     }
 
-    /// \brief Actualizeaza reteaua pe baza pozitiilor elementelor din harta particulelor furnizata.
-    /// \param particles O mapare ce contine particulele cu identificatorii lor ca chei.
-    void update(std::map<int, std::shared_ptr<T>>& particles)
+    /// \brief Actualizeaza reteaua pe baza pozitiilor elementelor din stocarea de particule furnizata.
+    ///
+    /// In modul GridUpdateMode::CountingSort apeleaza rebuild(); in modul GridUpdateMode::Incremental muta doar
+    /// particulele care au schimbat celula.
+    /// \param particles Stocarea particulelor, indexata dupa ID-ul dens al particulei.
+    void update(const T& particles)
     {
-        for (auto elem : particles)
+        float largestRadius = maxParticleRadius(particles);
+        if (options.autoCellSize && largestRadius != tunedMaxRadius)
+            tune(particles);
+
+        // cate inele de celule vecine trebuie cautate ca doua particule care se suprapun sa fie gasite
+        float smallestSide = std::min(cellWidth, cellHeight);
+        reach = std::max(1, static_cast<int>(std::ceil(2.f * largestRadius / smallestSide)));
+
+        if (options.updateMode == GridUpdateMode::CountingSort)
+        {
+            rebuild(particles);
+            return;
+        }
+
+        for (int id = 0; id < (int)particles.size(); id++)
         {
             // verifica daca particula apartine aceleiasi celule ca inainte
-            int oldIndex = idToIndexMap[elem.second->getId()];
-            int newIndex = (elem.second->getY() / cellHeight) * cols + (elem.second->getX() / cellWidth) - 2;
+            int oldIndex = id < (int)idToIndex.size() ? idToIndex[id] : -1;
+            int newIndex = cellIndex(particles.x[id], particles.y[id]);
 
             // elementul a parasit celula originala
             if (oldIndex != newIndex)
             {
                 // elimina din celula veche
-                remove(elem.second->getId());
+                remove(id);
 
                 // re-insereaza
-                insert(elem.second->getId(), elem.second->getX(), elem.second->getY());
+                insert(id, particles.x[id], particles.y[id]);
             }
         }
     }
 
-    /// \brief Obtine un vector de identificatori de elemente in celulele adiacente celei care contine identificatorul specificat.
-    /// \param id Identificatorul elementului de interogat.
-    /// \return Un vector de identificatori de elemente in celulele adiacente.
-    std::vector<int> query(int id)
+    /// \brief Reconstruieste reteaua printr-o sortare prin numarare a particulelor dupa celula.
+    ///
+    /// Calculeaza celula fiecarei particule, numara particulele din fiecare celula, transforma numerele in pozitii
+    /// (suma prefixelor, in cellStart) si scrie ID-urile in cellItems, in ordinea celulelor.
+    /// \param particles Stocarea particulelor, indexata dupa ID-ul dens al particulei.
+    void rebuild(const T& particles)
     {
-        std::vector<int> result;
+        int particleCount = (int)particles.size();
+        int cellCount = rows * cols;
 
-        int index = idToIndexMap[id];
-
-        if (grid[index].itemIds.empty())
+        idToIndex.resize(particleCount);
+        cellStart.assign(cellCount + 1, 0);
+        for (int id = 0; id < particleCount; id++)
         {
-            return result;
+            int index = cellIndex(particles.x[id], particles.y[id]);
+            idToIndex[id] = index;
+            cellStart[index + 1]++;
         }
 
-        // indicii celulelor in jurul obiectului selectat
-        int topLeft = index - cols - 1;
-        int topMid = index - cols;
-        int topRight = index - cols + 1;
+        for (int c = 0; c < cellCount; c++)
+            cellStart[c + 1] += cellStart[c];
+
+        cellFill.assign(cellStart.begin(), cellStart.end() - 1);
+        cellItems.resize(particleCount);
+        for (int id = 0; id < particleCount; id++)
+            cellItems[cellFill[idToIndex[id]]++] = id;
+    }
+
+    /// \brief Apeleaza visit pentru fiecare element din celula elementului specificat si din celulele vecine, fara alocari.
+    ///
+    /// Se cauta getReach() inele de celule in jurul celulei elementului (de obicei unul, adica 8 celule vecine).
+    /// Elementul insusi este si el vizitat.
+    /// \param id Identificatorul elementului de interogat.
+    /// \param visit Functia apelata cu identificatorul fiecarui element gasit.
+    template <typename Visitor>
+    void forEachNeighbour(int id, Visitor&& visit) const
+    {
+        int index = id < (int)idToIndex.size() ? idToIndex[id] : -1;
+        if (index < 0)
+            return;
+
+        int row = index / cols;
+        int col = index % cols;
+        int firstCol = std::max(col - reach, 0);
+        int lastCol = std::min(col + reach, cols - 1);
+
+        for (int r = row - reach; r <= row + reach; r++)
+        {
+            if (r < 0 || r >= rows)
+                continue;
 
-        int indexLeft = index - 1;
-        int indexRight = index + 1;
+            if (options.updateMode == GridUpdateMode::CountingSort)
+            {
+                // celulele vecine de pe acelasi rand sunt un singur interval din cellItems
+                int end = cellStart[r * cols + lastCol + 1];
+                for (int i = cellStart[r * cols + firstCol]; i < end; i++)
+                    visit(cellItems[i]);
+            }
+            else
+            {
+                for (int c = firstCol; c <= lastCol; c++)
+                    for (int other : grid[r * cols + c].itemIds)
+                        visit(other);
+            }
+        }
+    }
 
-        int bottomLeft = index + cols - 1;
-        int bottomMid = index + cols;
-        int bottomRight = index + cols + 1;
+    /// \brief Apeleaza visit o singura data pentru fiecare pereche de elemente aflate in aceeasi celula sau in celule vecine, fara alocari.
+    ///
+    /// Fiecare celula este combinata cu ea insasi si doar cu jumatatea "inainte" a vecinatatii: celulele din dreapta
+    /// de pe acelasi rand si celulele de pe randurile de dedesubt (stanga jos, jos, dreapta jos pentru un inel).
+    /// Astfel fiecare pereche neordonata apare exact o data, spre deosebire de forEachNeighbour apelat pentru fiecare
+    /// element, care da fiecare pereche de doua ori (A cu B si B cu A).
+    /// \param visit Functia apelata cu cele doua ID-uri ale fiecarei perechi.
+    template <typename Visitor>
+    void forEachCandidatePair(Visitor&& visit) const
+    {
+        for (int row = 0; row < rows; row++)
+            for (int col = 0; col < cols; col++)
+                forEachCandidatePairInCell(row, col, visit);
+    }
 
-        std::array<int, 9> cellsForQuery{ topLeft, topMid, topRight,
-                                         indexLeft, index, indexRight,
-                                         bottomLeft, bottomMid, bottomRight };
+    /// \brief Apeleaza visit pentru perechile pe care forEachCandidatePair le formeaza pornind de la o singura celula.
+    ///
+    /// Perechile unei celule (row, col) contin doar elemente din celulele de pe randurile [row, row + reach] si de pe
+    /// coloanele [col - reach, col + reach]. Doua celule aflate la cel putin getColorStrideX() coloane sau
+    /// getColorStrideY() randuri distanta nu ating deci aceleasi elemente si pot fi procesate in paralel.
+    /// \param row Randul celulei.
+    /// \param col Coloana celulei.
+    /// \param visit Functia apelata cu cele doua ID-uri ale fiecarei perechi.
+    template <typename Visitor>
+    void forEachCandidatePairInCell(int row, int col, Visitor&& visit) const
+    {
+        int index = row * cols + col;
+        int firstCol = std::max(col - reach, 0);
+        int lastCol = std::min(col + reach, cols - 1);
+        int lastRow = std::min(row + reach, rows - 1);
 
-        for (auto elem : cellsForQuery)
+        if (options.updateMode == GridUpdateMode::CountingSort)
         {
-            if (elem >= 0 && elem < grid.size())
+            int begin = cellStart[index];
+            int end = cellStart[index + 1];
+            for (int i = begin; i < end; i++)
             {
-                result.insert(result.end(), grid[elem].itemIds.begin(), grid[elem].itemIds.end());
+                int id = cellItems[i];
+
+                // restul celulei si celulele din dreapta sunt un singur interval din cellItems
+                int rightEnd = cellStart[row * cols + lastCol + 1];
+                for (int j = i + 1; j < rightEnd; j++)
+                    visit(id, cellItems[j]);
+
+                for (int r = row + 1; r <= lastRow; r++)
+                {
+                    int rowEnd = cellStart[r * cols + lastCol + 1];
+                    for (int j = cellStart[r * cols + firstCol]; j < rowEnd; j++)
+                        visit(id, cellItems[j]);
+                }
+            }
+        }
+        else
+        {
+            const auto& items = grid[index].itemIds;
+            for (size_t i = 0; i < items.size(); i++)
+            {
+                int id = items[i];
+
+                for (size_t j = i + 1; j < items.size(); j++)
+                    visit(id, items[j]);
+
+                for (int c = col + 1; c <= lastCol; c++)
+                    for (int other : grid[row * cols + c].itemIds)
+                        visit(id, other);
+
+                for (int r = row + 1; r <= lastRow; r++)
+                    for (int c = firstCol; c <= lastCol; c++)
+                        for (int other : grid[r * cols + c].itemIds)
+                            visit(id, other);
             }
         }
+    }
+
+    /// \brief Obtine distanta, in coloane, dintre doua celule de aceeasi culoare.
+    ///
+    /// Culoarea celulei (row, col) este (row % getColorStrideY()) * getColorStrideX() + col % getColorStrideX().
+    /// Pentru un inel de vecini (reach = 1) rezulta 3 x 2 culori.
+    /// \return 2 * reach + 1.
+    int getColorStrideX() const
+    {
+        return 2 * reach + 1;
+    }
+
+    /// \brief Obtine distanta, in randuri, dintre doua celule de aceeasi culoare.
+    /// \return reach + 1.
+    int getColorStrideY() const
+    {
+        return reach + 1;
+    }
+
+    /// \brief Obtine un vector de identificatori de elemente in celulele adiacente celei care contine identificatorul specificat.
+    /// \param id Identificatorul elementului de interogat.
+    /// \return Un vector de identificatori de elemente in celulele adiacente.
+    std::vector<int> query(int id)
+    {
+        std::vector<int> result;
+
+        forEachNeighbour(id, [&result](int other) { result.push_back(other); });
 
         return result;
     }
@@ -173,11 +434,35 @@ public:
         return cols;
     }
 
+    /// \brief Obtine latimea unei celule.
+    /// \return Latimea unei celule.
+    float getCellWidth() const
+    {
+        return cellWidth;
+    }
+
+    /// \brief Obtine inaltimea unei celule.
+    /// \return Inaltimea unei celule.
+    float getCellHeight() const
+    {
+        return cellHeight;
+    }
+
+    /// \brief Obtine numarul de inele de celule vecine cautate de forEachNeighbour.
+    /// \return Numarul de inele (1 = vecinatatea 3x3).
+    int getReach() const
+    {
+        return reach;
+    }
+
     /// \brief Reseteaza reteaua prin stergerea tuturor celulelor si a maparii ID-ului catre index.
     void reset()
     {
         grid.clear();
-        idToIndexMap.clear();
+        idToIndex.clear();
+        cellStart.clear();
+        cellFill.clear();
+        cellItems.clear();
     }
 
     /// \brief Calculeaza dimensiunea totala a structurii de date.
@@ -185,17 +470,17 @@ public:
     size_t sizeOfDataStructure()
     {
         size_t count = 0;
-        for (auto elem : idToIndexMap)
-        {
-            count += sizeof(elem.first);
-            count += sizeof(elem.second);
-        }
+        count += idToIndex.size() * sizeof(int);
 
-        for (auto elem : grid)
+        // ID-urile din celule sunt numarate in bytes, ca restul structurii (versiunile vechi le numarau ca elemente)
+        for (const auto& elem : grid)
         {
-            count += elem.itemIds.size();
+            count += elem.itemIds.size() * sizeof(int);
         }
 
+        count += (cellStart.size() + cellFill.size() + cellItems.size()) * sizeof(int);
+        count += diameters.size() * sizeof(float);
+
         count += sizeof(rows);
         count += sizeof(cols);
         count += sizeof(cellWidth);
@@ -205,10 +490,33 @@ public:
     }
 
 private:
+    /// \brief Calculeaza celula in care se afla un punct; punctele din afara retelei sunt puse in celula cea mai apropiata.
+    /// \param centerX Coordonata X a punctului.
+    /// \param centerY Coordonata Y a punctului.
+    /// \return Indexul celulei.
+    int cellIndex(float centerX, float centerY) const
+    {
+        int bigY = (int)(centerY / cellHeight);
+        int bigX = (int)(centerX / cellWidth);
+        bigY = bigY < 0 ? 0 : (bigY >= rows ? rows - 1 : bigY);
+        bigX = bigX < 0 ? 0 : (bigX >= cols ? cols - 1 : bigX);
+
+        return bigY * cols + bigX;
+    }
+
     int rows;                      ///< Numarul de randuri in retea.
     int cols;                      ///< Numarul de coloane in retea.
+    int screenWidth;               ///< Latimea spatiului acoperit de retea.
+    int screenHeight;              ///< Inaltimea spatiului acoperit de retea.
     float cellWidth;               ///< Latimea fiecarei celule.
     float cellHeight;              ///< Inaltimea fiecarei celule.
-    std::vector<Cell> grid;        ///< Reteaua care contine celulele.
-    std::map<int, int> idToIndexMap; ///< Mapare pentru a stoca identificatori de elemente si indicii celulelor corespunzatoare.
+    int reach = 1;                 ///< Numarul de inele de celule vecine cautate.
+    float tunedMaxRadius = -1.f;   ///< Raza maxima pentru care a fost aleasa dimensiunea celulelor (-1 = inca nealeasa).
+    std::vector<float> diameters;  ///< Diametrele particulelor, refolosite la alegerea dimensiunii celulelor.
+    GridOptions options;           ///< Parametrii retelei.
+    std::vector<Cell> grid;        ///< Reteaua care contine celulele (modul GridUpdateMode::Incremental).
+    std::vector<int> idToIndex;    ///< Indexul celulei pentru fiecare identificator de element (-1 daca elementul nu este in retea).
+    std::vector<int> cellStart;    ///< Pozitia primului element al fiecarei celule in cellItems, plus numarul total la final (modul GridUpdateMode::CountingSort).
+    std::vector<int> cellFill;     ///< Pozitia urmatoare de scris pentru fiecare celula, folosita in timpul reconstructiei.
+    std::vector<int> cellItems;    ///< ID-urile tuturor elementelor, sortate dupa celula (modul GridUpdateMode::CountingSort).
 };
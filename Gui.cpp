@@ -1,6 +1,6 @@
 #include "Gui.h"
 
-Gui::Gui(ParticleManager& pm) : programState(ProgramState::Simulation), pm(pm), screenWidth(pm.getScreenWidth()), screenHeight(pm.getScreenHeight()), isPaused(false)
+Gui::Gui(ParticleManager& pm) : programState(ProgramState::Simulation), pm(pm), pipeline(pm), screenWidth(pm.getScreenWidth()), screenHeight(pm.getScreenHeight()), isPaused(false)
 {
     InitWindow(screenWidth, screenHeight, "Particle simulator");
     //SetWindowState(FLAG_VSYNC_HINT);
@@ -23,11 +23,25 @@ Gui::Gui(ParticleManager& pm) : programState(ProgramState::Simulation), pm(pm),
 
 Gui::~Gui()
 {
+    renderer.unload();
     CloseWindow();
 }
 
+void Gui::setPipelined(bool pipelined)
+{
+    this->pipelined = pipelined;
+}
+
+void Gui::setRenderMode(ParticleRenderMode mode)
+{
+    renderer.setMode(mode);
+}
+
 void Gui::Run()
 {
+    if (pipelined)
+        pipeline.start();
+
     while (!WindowShouldClose())
     {
         drawMenuButton();
@@ -55,6 +69,7 @@ void Gui::Run()
         }
         else if (programState == ProgramState::Lines)
         {
+            auto hold = pipeline.holdSimulation();
             pm.toggleLines();
             programState = ProgramState::MainMenu;
         }
@@ -70,9 +85,11 @@ void Gui::Run()
         }
         else if (programState == ProgramState::ExitToDesktop)
         {
-            return;
+            break;
         }
     }
+
+    pipeline.stop();
 }
 
 void Gui::takeInputNumberOfParticles()
@@ -136,6 +153,7 @@ void Gui::takeInputNumberOfParticles()
             return;
         }
 
+        auto hold = pipeline.holdSimulation();
         pm.updateNumberOfParticles(nParticles);
         inputNumberBox.clear();
         inputN = false;
@@ -222,6 +240,7 @@ void Gui::takeInputVelocity()
             return;
         }
 
+        auto hold = pipeline.holdSimulation();
         pm.updateParticleVelocity(newVelocity);
         inputVelocityBox.clear();
         inputVelocity = false;
@@ -273,21 +292,38 @@ void Gui::updateAlgoOptions()
     if (selectedOption == 0)
     {
         // QuadTree
+        auto hold = pipeline.holdSimulation();
         pm.startQuadTree();
         selectedOption = -1;
     }
     else if (selectedOption == 1)
     {
         // Grid
+        auto hold = pipeline.holdSimulation();
         pm.startGrid();
         selectedOption = -1;
     }
     else if (selectedOption == 2)
     {
         // Bounding Volume
+        auto hold = pipeline.holdSimulation();
         pm.startBoundingVolume();
         selectedOption = -1;
     }
+    else if (selectedOption == 3)
+    {
+        // Sweep and Prune
+        auto hold = pipeline.holdSimulation();
+        pm.startSweepAndPrune();
+        selectedOption = -1;
+    }
+    else if (selectedOption == 4)
+    {
+        // Brute Force
+        auto hold = pipeline.holdSimulation();
+        pm.startBruteForce();
+        selectedOption = -1;
+    }
 }
 
 void Gui::drawAlgoOptions()
@@ -416,7 +452,11 @@ void Gui::drawMenuButton()
 }
 
 void Gui::update() {
-    if (!isPaused) {
+    if (pipelined) {
+        // simularea ruleaza pe firul din SimulationPipeline
+        pipeline.setPaused(isPaused);
+    }
+    else if (!isPaused) {
         previousTime = currentTime;
         currentTime = GetTime();
         float deltaT = (float)(currentTime - previousTime);
@@ -440,7 +480,15 @@ void Gui::draw() {
 
     ClearBackground(WHITE);
     DrawFPS(10, 10);
-    pm.drawParticles();
+    if (pipelined)
+    {
+        renderer.draw(pipeline.acquireFrame());
+    }
+    else
+    {
+        pm.captureFrame(frame);
+        renderer.draw(frame);
+    }
 
     if (isPaused) {
         DrawText("Simulation Paused", screenWidth / 2 - MeasureText("Simulation Paused", 40) / 2, 0 + 40, 40, GRAY);
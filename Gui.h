@@ -1,11 +1,13 @@
 #pragma once
 #include "raylib.h"
 #include "ParticleManager.h"
+#include "SimulationPipeline.h"
+#include "ParticleRenderer.h"
 #include <chrono>
 #include <string>
 #include <iostream>
 #define MAX_OPTIONS 5
-#define ALGO_OPTIONS 3
+#define ALGO_OPTIONS 5
 #define MAX_INPUT_LENGTH 5
 
 /**
@@ -45,6 +47,18 @@ public:
      */
     void Run();
 
+    /**
+     * \brief Alege intre simularea si desenarea pe acelasi fir si simularea pe un fir separat (SimulationPipeline).
+     * \param pipelined `true` pentru simularea pe un fir separat.
+     */
+    void setPipelined(bool pipelined);
+
+    /**
+     * \brief Alege modul de desenare a particulelor.
+     * \param mode Modul de desenare (implicit ParticleRenderMode::Instanced).
+     */
+    void setRenderMode(ParticleRenderMode mode);
+
     /**
      * \brief Preia valoarea pentru numarul de particule introdusa de utilizator.
      */
@@ -111,6 +125,10 @@ private:
     bool isPaused;                              ///< Indicator pentru pauza.
     ProgramState programState;                   ///< Starea programului.
     ParticleManager& pm;                        ///< Referinta la ParticleManager.
+    SimulationPipeline pipeline;                ///< Simularea pe un fir separat, folosita cand pipelined este true.
+    bool pipelined = false;                     ///< Indicator pentru simularea pe un fir separat.
+    ParticleRenderer renderer;                  ///< Desenarea particulelor in loturi.
+    RenderFrame frame;                          ///< Instantaneul desenat cand simularea ruleaza pe firul interfetei.
     double previousTime;                        ///< Timpul anterior.
     double currentTime;                         ///< Timpul curent.
 
@@ -125,7 +143,9 @@ private:
     const char* algoOptions[ALGO_OPTIONS] = {
         "Quad Tree",
         "Grid",
-        "Volum Delimitator"
+        "Volum Delimitator",
+        "Sweep and Prune",
+        "Forta Bruta"
     };                                          ///< Optiunile meniului algoritmilor.
 
     int selectedOption = -1;                     ///< Optiunea selectata.
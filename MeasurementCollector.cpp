@@ -20,4 +20,16 @@ void MeasurementCollector::insertSize(std::string fnName, size_t size, int numbe
 std::map<std::string, std::pair<int, size_t>>& MeasurementCollector::getSizes()
 {
 	return storeSizes;
+}
+
+void MeasurementCollector::insertParameter(std::string fnName, double value, int numberOfItems)
+{
+	fnName += std::to_string(numberOfItems);
+	// parametrii se pot schimba pe parcursul rularii; se pastreaza ultima valoare
+	storeParameters[fnName] = std::make_pair(numberOfItems, value);
+}
+
+std::map<std::string, std::pair<int, double>>& MeasurementCollector::getParameters()
+{
+	return storeParameters;
 }
\ No newline at end of file
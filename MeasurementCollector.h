@@ -41,7 +41,24 @@ public:
      */
     std::map<std::string, std::pair<int, size_t>>& getSizes();
 
+    /**
+     * \brief Insereaza un parametru ales la rulare (de exemplu dimensiunea celulelor retelei) in colector.
+     *
+     * Un parametru inserat din nou cu acelasi nume si acelasi numar de elemente isi inlocuieste valoarea anterioara.
+     * \param name Numele parametrului.
+     * \param value Valoarea parametrului.
+     * \param numberOfItems Numarul de elemente.
+     */
+    void insertParameter(std::string name, double value, int numberOfItems);
+
+    /**
+     * \brief Obtine toti parametrii din colector.
+     * \return Un map cu toti parametrii, avand numele ca cheie si o pereche de valori (numarul de elemente, valoarea) ca valoare.
+     */
+    std::map<std::string, std::pair<int, double>>& getParameters();
+
 private:
     std::map<std::string, std::pair<int, double>> storeTimers;  ///< Map pentru stocarea timerelelor.
     std::map<std::string, std::pair<int, size_t>> storeSizes;   ///< Map pentru stocarea dimensiunilor.
+    std::map<std::string, std::pair<int, double>> storeParameters; ///< Map pentru stocarea parametrilor.
 };
\ No newline at end of file
@@ -0,0 +1,475 @@
+#include "ParticleKernels.h"
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PARTICLE_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// Variantele vectoriale trebuie sa rotunjeasca exact ca varianta scalara, deci compilatorul nu are voie
+// sa contracte inmultirea si adunarea intr-o singura instructiune FMA (nici in codul scalar, nici in intrinsici).
+#if defined(_MSC_VER) && !defined(__clang__)
+#pragma fp_contract(off)
+#elif defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+// GCC/Clang compileaza intrinsicile AVX doar in functii marcate cu setul de instructiuni tinta;
+// MSVC le accepta oriunde, asa ca macro-ul nu are efect acolo.
+#if defined(__GNUC__) || defined(__clang__)
+#define PARTICLE_TARGET(isa) __attribute__((target(isa)))
+#else
+#define PARTICLE_TARGET(isa)
+#endif
+
+namespace
+{
+	// Numarul de particule dintr-un bloc al testului pe toate perechile: x, y si raza unui bloc (12 KB) raman in cache
+	// cat timp blocul este comparat cu toate particulele dinaintea lui.
+	const size_t PAIR_BLOCK_SIZE = 1024;
+
+	// Suma razelor este marita cu acest factor, ca testul pe patrate sa includa si perechile aflate la limita
+	// pentru testul cu radacina patrata din CheckCollisionCircles.
+	const float PAIR_RADIUS_SLACK = 1.0001f;
+
+	inline bool overlapsScalar(const ParticleStore& p, size_t i, size_t j)
+	{
+		float dx = p.x[j] - p.x[i];
+		float dy = p.y[j] - p.y[i];
+		float radiusSum = (p.radius[j] + p.radius[i]) * PAIR_RADIUS_SLACK;
+
+		return dx * dx + dy * dy <= radiusSum * radiusSum;
+	}
+
+	// Compara particula i cu particulele [begin, end) si adauga perechile gasite.
+	void overlapRowScalar(const ParticleStore& p, size_t i, size_t begin, size_t end, std::vector<std::pair<int, int>>& pairs)
+	{
+		for (size_t j = begin; j < end; j++)
+			if (overlapsScalar(p, i, j))
+				pairs.emplace_back(static_cast<int>(i), static_cast<int>(j));
+	}
+
+#ifdef PARTICLE_KERNELS_X86
+	// Adauga perechile indicate de bitii dintr-o masca, pentru particulele [j, j + latimea registrului).
+	inline void emitMask(unsigned int mask, size_t i, size_t j, std::vector<std::pair<int, int>>& pairs)
+	{
+		while (mask)
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			unsigned long bit;
+			_BitScanForward(&bit, mask);
+#else
+			unsigned int bit = static_cast<unsigned int>(__builtin_ctz(mask));
+#endif
+			pairs.emplace_back(static_cast<int>(i), static_cast<int>(j + bit));
+			mask &= mask - 1;
+		}
+	}
+#endif
+
+	// Varianta scalara: codul de referinta din ParticleStore, folosit si pentru particulele ramase
+	// dupa ultimul bloc vectorial.
+	void integrateScalar(ParticleStore& p, size_t begin, size_t end, float deltaT, int frameWidth, int frameHeight)
+	{
+		for (size_t id = begin; id < end; id++)
+		{
+			p.x[id] += p.vx[id] * deltaT;
+			p.y[id] += p.vy[id] * deltaT;
+
+			p.solveCollisionWithFrame(static_cast<int>(id), frameWidth, frameHeight);
+		}
+	}
+
+#ifdef PARTICLE_KERNELS_X86
+	// Reflexia pentru o margine: daca marginea este atinsa, conditia A are prioritate fata de B
+	// (la fel ca if / else if din varianta scalara).
+	inline __m128 selectSse(__m128 mask, __m128 a, __m128 b)
+	{
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+	}
+
+	inline void reflectSse(__m128 hit, __m128 condA, __m128 condB, float ax, float ay, float bx, float by, __m128& vx, __m128& vy)
+	{
+		__m128 maskA = _mm_and_ps(hit, condA);
+		__m128 maskB = _mm_andnot_ps(maskA, _mm_and_ps(hit, condB));
+
+		vx = selectSse(maskA, _mm_set1_ps(ax), selectSse(maskB, _mm_set1_ps(bx), vx));
+		vy = selectSse(maskA, _mm_set1_ps(ay), selectSse(maskB, _mm_set1_ps(by), vy));
+	}
+
+	size_t integrateSse(ParticleStore& p, size_t begin, size_t end, float deltaT, int frameWidth, int frameHeight)
+	{
+		const __m128 dt = _mm_set1_ps(deltaT);
+		const __m128 width = _mm_set1_ps(static_cast<float>(frameWidth));
+		const __m128 height = _mm_set1_ps(static_cast<float>(frameHeight));
+		const __m128 zero = _mm_setzero_ps();
+
+		size_t id = begin;
+		for (; id + 4 <= end; id += 4)
+		{
+			__m128 x = _mm_loadu_ps(&p.x[id]);
+			__m128 y = _mm_loadu_ps(&p.y[id]);
+			__m128 vx = _mm_loadu_ps(&p.vx[id]);
+			__m128 vy = _mm_loadu_ps(&p.vy[id]);
+			__m128 r = _mm_loadu_ps(&p.radius[id]);
+
+			x = _mm_add_ps(x, _mm_mul_ps(vx, dt));
+			y = _mm_add_ps(y, _mm_mul_ps(vy, dt));
+
+			// bottom
+			reflectSse(_mm_cmpgt_ps(_mm_add_ps(y, r), height),
+				_mm_and_ps(_mm_cmpgt_ps(vx, zero), _mm_cmpgt_ps(vy, zero)),
+				_mm_and_ps(_mm_cmplt_ps(vx, zero), _mm_cmpgt_ps(vy, zero)),
+				3.0f, -3.0f, -3.0f, -3.0f, vx, vy);
+			// left side
+			reflectSse(_mm_cmplt_ps(_mm_sub_ps(x, r), zero),
+				_mm_and_ps(_mm_cmplt_ps(vx, zero), _mm_cmplt_ps(vy, zero)),
+				_mm_and_ps(_mm_cmplt_ps(vx, zero), _mm_cmpgt_ps(vy, zero)),
+				3.0f, -3.0f, 3.0f, 3.0f, vx, vy);
+			// right side
+			reflectSse(_mm_cmpgt_ps(_mm_add_ps(x, r), width),
+				_mm_and_ps(_mm_cmpgt_ps(vx, zero), _mm_cmpgt_ps(vy, zero)),
+				_mm_and_ps(_mm_cmpgt_ps(vx, zero), _mm_cmplt_ps(vy, zero)),
+				-3.0f, 3.0f, -3.0f, -3.0f, vx, vy);
+			// top
+			reflectSse(_mm_cmplt_ps(_mm_sub_ps(y, r), zero),
+				_mm_and_ps(_mm_cmpgt_ps(vx, zero), _mm_cmplt_ps(vy, zero)),
+				_mm_and_ps(_mm_cmplt_ps(vx, zero), _mm_cmplt_ps(vy, zero)),
+				3.0f, 3.0f, -3.0f, 3.0f, vx, vy);
+
+			_mm_storeu_ps(&p.x[id], x);
+			_mm_storeu_ps(&p.y[id], y);
+			_mm_storeu_ps(&p.vx[id], vx);
+			_mm_storeu_ps(&p.vy[id], vy);
+		}
+
+		return id;
+	}
+
+	PARTICLE_TARGET("avx2")
+	inline void reflectAvx2(__m256 hit, __m256 condA, __m256 condB, float ax, float ay, float bx, float by, __m256& vx, __m256& vy)
+	{
+		__m256 maskA = _mm256_and_ps(hit, condA);
+		__m256 maskB = _mm256_andnot_ps(maskA, _mm256_and_ps(hit, condB));
+
+		vx = _mm256_blendv_ps(_mm256_blendv_ps(vx, _mm256_set1_ps(bx), maskB), _mm256_set1_ps(ax), maskA);
+		vy = _mm256_blendv_ps(_mm256_blendv_ps(vy, _mm256_set1_ps(by), maskB), _mm256_set1_ps(ay), maskA);
+	}
+
+	PARTICLE_TARGET("avx2")
+	size_t integrateAvx2(ParticleStore& p, size_t begin, size_t end, float deltaT, int frameWidth, int frameHeight)
+	{
+		const __m256 dt = _mm256_set1_ps(deltaT);
+		const __m256 width = _mm256_set1_ps(static_cast<float>(frameWidth));
+		const __m256 height = _mm256_set1_ps(static_cast<float>(frameHeight));
+		const __m256 zero = _mm256_setzero_ps();
+
+		size_t id = begin;
+		for (; id + 8 <= end; id += 8)
+		{
+			__m256 x = _mm256_loadu_ps(&p.x[id]);
+			__m256 y = _mm256_loadu_ps(&p.y[id]);
+			__m256 vx = _mm256_loadu_ps(&p.vx[id]);
+			__m256 vy = _mm256_loadu_ps(&p.vy[id]);
+			__m256 r = _mm256_loadu_ps(&p.radius[id]);
+
+			x = _mm256_add_ps(x, _mm256_mul_ps(vx, dt));
+			y = _mm256_add_ps(y, _mm256_mul_ps(vy, dt));
+
+			// bottom
+			reflectAvx2(_mm256_cmp_ps(_mm256_add_ps(y, r), height, _CMP_GT_OQ),
+				_mm256_and_ps(_mm256_cmp_ps(vx, zero, _CMP_GT_OQ), _mm256_cmp_ps(vy, zero, _CMP_GT_OQ)),
+				_mm256_and_ps(_mm256_cmp_ps(vx, zero, _CMP_LT_OQ), _mm256_cmp_ps(vy, zero, _CMP_GT_OQ)),
+				3.0f, -3.0f, -3.0f, -3.0f, vx, vy);
+			// left side
+			reflectAvx2(_mm256_cmp_ps(_mm256_sub_ps(x, r), zero, _CMP_LT_OQ),
+				_mm256_and_ps(_mm256_cmp_ps(vx, zero, _CMP_LT_OQ), _mm256_cmp_ps(vy, zero, _CMP_LT_OQ)),
+				_mm256_and_ps(_mm256_cmp_ps(vx, zero, _CMP_LT_OQ), _mm256_cmp_ps(vy, zero, _CMP_GT_OQ)),
+				3.0f, -3.0f, 3.0f, 3.0f, vx, vy);
+			// right side
+			reflectAvx2(_mm256_cmp_ps(_mm256_add_ps(x, r), width, _CMP_GT_OQ),
+				_mm256_and_ps(_mm256_cmp_ps(vx, zero, _CMP_GT_OQ), _mm256_cmp_ps(vy, zero, _CMP_GT_OQ)),
+				_mm256_and_ps(_mm256_cmp_ps(vx, zero, _CMP_GT_OQ), _mm256_cmp_ps(vy, zero, _CMP_LT_OQ)),
+				-3.0f, 3.0f, -3.0f, -3.0f, vx, vy);
+			// top
+			reflectAvx2(_mm256_cmp_ps(_mm256_sub_ps(y, r), zero, _CMP_LT_OQ),
+				_mm256_and_ps(_mm256_cmp_ps(vx, zero, _CMP_GT_OQ), _mm256_cmp_ps(vy, zero, _CMP_LT_OQ)),
+				_mm256_and_ps(_mm256_cmp_ps(vx, zero, _CMP_LT_OQ), _mm256_cmp_ps(vy, zero, _CMP_LT_OQ)),
+				3.0f, 3.0f, -3.0f, 3.0f, vx, vy);
+
+			_mm256_storeu_ps(&p.x[id], x);
+			_mm256_storeu_ps(&p.y[id], y);
+			_mm256_storeu_ps(&p.vx[id], vx);
+			_mm256_storeu_ps(&p.vy[id], vy);
+		}
+
+		return id;
+	}
+
+	PARTICLE_TARGET("avx512f")
+	inline void reflectAvx512(__mmask16 hit, __mmask16 condA, __mmask16 condB, float ax, float ay, float bx, float by, __m512& vx, __m512& vy)
+	{
+		__mmask16 maskA = hit & condA;
+		__mmask16 maskB = hit & condB & static_cast<__mmask16>(~maskA);
+
+		vx = _mm512_mask_blend_ps(maskA, _mm512_mask_blend_ps(maskB, vx, _mm512_set1_ps(bx)), _mm512_set1_ps(ax));
+		vy = _mm512_mask_blend_ps(maskA, _mm512_mask_blend_ps(maskB, vy, _mm512_set1_ps(by)), _mm512_set1_ps(ay));
+	}
+
+	PARTICLE_TARGET("avx512f")
+	size_t integrateAvx512(ParticleStore& p, size_t begin, size_t end, float deltaT, int frameWidth, int frameHeight)
+	{
+		const __m512 dt = _mm512_set1_ps(deltaT);
+		const __m512 width = _mm512_set1_ps(static_cast<float>(frameWidth));
+		const __m512 height = _mm512_set1_ps(static_cast<float>(frameHeight));
+		const __m512 zero = _mm512_setzero_ps();
+
+		size_t id = begin;
+		for (; id + 16 <= end; id += 16)
+		{
+			__m512 x = _mm512_loadu_ps(&p.x[id]);
+			__m512 y = _mm512_loadu_ps(&p.y[id]);
+			__m512 vx = _mm512_loadu_ps(&p.vx[id]);
+			__m512 vy = _mm512_loadu_ps(&p.vy[id]);
+			__m512 r = _mm512_loadu_ps(&p.radius[id]);
+
+			x = _mm512_add_ps(x, _mm512_mul_ps(vx, dt));
+			y = _mm512_add_ps(y, _mm512_mul_ps(vy, dt));
+
+			// bottom
+			reflectAvx512(_mm512_cmp_ps_mask(_mm512_add_ps(y, r), height, _CMP_GT_OQ),
+				_mm512_cmp_ps_mask(vx, zero, _CMP_GT_OQ) & _mm512_cmp_ps_mask(vy, zero, _CMP_GT_OQ),
+				_mm512_cmp_ps_mask(vx, zero, _CMP_LT_OQ) & _mm512_cmp_ps_mask(vy, zero, _CMP_GT_OQ),
+				3.0f, -3.0f, -3.0f, -3.0f, vx, vy);
+			// left side
+			reflectAvx512(_mm512_cmp_ps_mask(_mm512_sub_ps(x, r), zero, _CMP_LT_OQ),
+				_mm512_cmp_ps_mask(vx, zero, _CMP_LT_OQ) & _mm512_cmp_ps_mask(vy, zero, _CMP_LT_OQ),
+				_mm512_cmp_ps_mask(vx, zero, _CMP_LT_OQ) & _mm512_cmp_ps_mask(vy, zero, _CMP_GT_OQ),
+				3.0f, -3.0f, 3.0f, 3.0f, vx, vy);
+			// right side
+			reflectAvx512(_mm512_cmp_ps_mask(_mm512_add_ps(x, r), width, _CMP_GT_OQ),
+				_mm512_cmp_ps_mask(vx, zero, _CMP_GT_OQ) & _mm512_cmp_ps_mask(vy, zero, _CMP_GT_OQ),
+				_mm512_cmp_ps_mask(vx, zero, _CMP_GT_OQ) & _mm512_cmp_ps_mask(vy, zero, _CMP_LT_OQ),
+				-3.0f, 3.0f, -3.0f, -3.0f, vx, vy);
+			// top
+			reflectAvx512(_mm512_cmp_ps_mask(_mm512_sub_ps(y, r), zero, _CMP_LT_OQ),
+				_mm512_cmp_ps_mask(vx, zero, _CMP_GT_OQ) & _mm512_cmp_ps_mask(vy, zero, _CMP_LT_OQ),
+				_mm512_cmp_ps_mask(vx, zero, _CMP_LT_OQ) & _mm512_cmp_ps_mask(vy, zero, _CMP_LT_OQ),
+				3.0f, 3.0f, -3.0f, 3.0f, vx, vy);
+
+			_mm512_storeu_ps(&p.x[id], x);
+			_mm512_storeu_ps(&p.y[id], y);
+			_mm512_storeu_ps(&p.vx[id], vx);
+			_mm512_storeu_ps(&p.vy[id], vy);
+		}
+
+		return id;
+	}
+
+	size_t overlapRowSse(const ParticleStore& p, size_t i, size_t begin, size_t end, std::vector<std::pair<int, int>>& pairs)
+	{
+		const __m128 xi = _mm_set1_ps(p.x[i]);
+		const __m128 yi = _mm_set1_ps(p.y[i]);
+		const __m128 ri = _mm_set1_ps(p.radius[i]);
+		const __m128 slack = _mm_set1_ps(PAIR_RADIUS_SLACK);
+
+		size_t j = begin;
+		for (; j + 4 <= end; j += 4)
+		{
+			__m128 dx = _mm_sub_ps(_mm_loadu_ps(&p.x[j]), xi);
+			__m128 dy = _mm_sub_ps(_mm_loadu_ps(&p.y[j]), yi);
+			__m128 radiusSum = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&p.radius[j]), ri), slack);
+
+			__m128 distance = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+			emitMask(static_cast<unsigned int>(_mm_movemask_ps(_mm_cmple_ps(distance, _mm_mul_ps(radiusSum, radiusSum)))), i, j, pairs);
+		}
+
+		return j;
+	}
+
+	PARTICLE_TARGET("avx2")
+	size_t overlapRowAvx2(const ParticleStore& p, size_t i, size_t begin, size_t end, std::vector<std::pair<int, int>>& pairs)
+	{
+		const __m256 xi = _mm256_set1_ps(p.x[i]);
+		const __m256 yi = _mm256_set1_ps(p.y[i]);
+		const __m256 ri = _mm256_set1_ps(p.radius[i]);
+		const __m256 slack = _mm256_set1_ps(PAIR_RADIUS_SLACK);
+
+		size_t j = begin;
+		for (; j + 8 <= end; j += 8)
+		{
+			__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&p.x[j]), xi);
+			__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&p.y[j]), yi);
+			__m256 radiusSum = _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(&p.radius[j]), ri), slack);
+
+			__m256 distance = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+			__m256 hit = _mm256_cmp_ps(distance, _mm256_mul_ps(radiusSum, radiusSum), _CMP_LE_OQ);
+			emitMask(static_cast<unsigned int>(_mm256_movemask_ps(hit)), i, j, pairs);
+		}
+
+		return j;
+	}
+
+	PARTICLE_TARGET("avx512f")
+	size_t overlapRowAvx512(const ParticleStore& p, size_t i, size_t begin, size_t end, std::vector<std::pair<int, int>>& pairs)
+	{
+		const __m512 xi = _mm512_set1_ps(p.x[i]);
+		const __m512 yi = _mm512_set1_ps(p.y[i]);
+		const __m512 ri = _mm512_set1_ps(p.radius[i]);
+		const __m512 slack = _mm512_set1_ps(PAIR_RADIUS_SLACK);
+
+		size_t j = begin;
+		for (; j + 16 <= end; j += 16)
+		{
+			__m512 dx = _mm512_sub_ps(_mm512_loadu_ps(&p.x[j]), xi);
+			__m512 dy = _mm512_sub_ps(_mm512_loadu_ps(&p.y[j]), yi);
+			__m512 radiusSum = _mm512_mul_ps(_mm512_add_ps(_mm512_loadu_ps(&p.radius[j]), ri), slack);
+
+			__m512 distance = _mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy));
+			emitMask(_mm512_cmp_ps_mask(distance, _mm512_mul_ps(radiusSum, radiusSum), _CMP_LE_OQ), i, j, pairs);
+		}
+
+		return j;
+	}
+
+	SimdLevel queryCpu()
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		int maxLeaf = info[0];
+
+		__cpuid(info, 1);
+		bool sse2 = (info[3] & (1 << 26)) != 0;
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+
+		unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+		bool osAvx = (xcr0 & 0x6) == 0x6;
+		bool osAvx512 = (xcr0 & 0xE6) == 0xE6;
+
+		bool avx2 = false;
+		bool avx512 = false;
+		if (maxLeaf >= 7)
+		{
+			__cpuidex(info, 7, 0);
+			avx2 = (info[1] & (1 << 5)) != 0;
+			avx512 = (info[1] & (1 << 16)) != 0;
+		}
+
+		if (avx512 && osAvx512)
+			return SimdLevel::AVX512;
+		if (avx && avx2 && osAvx)
+			return SimdLevel::AVX2;
+		if (sse2)
+			return SimdLevel::SSE;
+		return SimdLevel::Scalar;
+#else
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx512f"))
+			return SimdLevel::AVX512;
+		if (__builtin_cpu_supports("avx2"))
+			return SimdLevel::AVX2;
+		if (__builtin_cpu_supports("sse2"))
+			return SimdLevel::SSE;
+		return SimdLevel::Scalar;
+#endif
+	}
+#endif
+}
+
+SimdLevel ParticleKernels::detectSimdLevel()
+{
+#ifdef PARTICLE_KERNELS_X86
+	static const SimdLevel level = queryCpu();
+	return level;
+#else
+	return SimdLevel::Scalar;
+#endif
+}
+
+const char* ParticleKernels::simdLevelName(SimdLevel level)
+{
+	switch (level)
+	{
+	case SimdLevel::Scalar:
+		return "Scalar";
+	case SimdLevel::SSE:
+		return "SSE2";
+	case SimdLevel::AVX2:
+		return "AVX2";
+	case SimdLevel::AVX512:
+		return "AVX-512";
+	}
+	return "Unknown";
+}
+
+void ParticleKernels::integrateAndReflect(ParticleStore& particles, float deltaT, int frameWidth, int frameHeight)
+{
+	integrateAndReflect(particles, 0, particles.size(), deltaT, frameWidth, frameHeight, detectSimdLevel());
+}
+
+void ParticleKernels::integrateAndReflect(ParticleStore& particles, size_t begin, size_t end, float deltaT, int frameWidth, int frameHeight, SimdLevel level)
+{
+	if (level > detectSimdLevel())
+		level = detectSimdLevel();
+
+	size_t id = begin;
+
+#ifdef PARTICLE_KERNELS_X86
+	if (level == SimdLevel::AVX512)
+		id = integrateAvx512(particles, id, end, deltaT, frameWidth, frameHeight);
+	else if (level == SimdLevel::AVX2)
+		id = integrateAvx2(particles, id, end, deltaT, frameWidth, frameHeight);
+	else if (level == SimdLevel::SSE)
+		id = integrateSse(particles, id, end, deltaT, frameWidth, frameHeight);
+#endif
+
+	integrateScalar(particles, id, end, deltaT, frameWidth, frameHeight);
+}
+
+void ParticleKernels::findOverlappingPairs(const ParticleStore& particles, std::vector<std::pair<int, int>>& pairs)
+{
+	findOverlappingPairs(particles, pairs, detectSimdLevel());
+}
+
+void ParticleKernels::findOverlappingPairs(const ParticleStore& particles, std::vector<std::pair<int, int>>& pairs, SimdLevel level)
+{
+	findOverlappingPairs(particles, 0, particles.size(), pairs, level);
+}
+
+void ParticleKernels::findOverlappingPairs(const ParticleStore& particles, size_t firstBegin, size_t firstEnd, std::vector<std::pair<int, int>>& pairs, SimdLevel level)
+{
+	if (level > detectSimdLevel())
+		level = detectSimdLevel();
+
+	pairs.clear();
+	size_t count = particles.size();
+
+	// fiecare bloc [blockBegin, blockEnd) este comparat cu toate particulele i din interval aflate inaintea lui si cu el insusi
+	for (size_t blockBegin = 0; blockBegin < count; blockBegin += PAIR_BLOCK_SIZE)
+	{
+		size_t blockEnd = std::min(blockBegin + PAIR_BLOCK_SIZE, count);
+
+		for (size_t i = firstBegin; i < firstEnd && i + 1 < blockEnd; i++)
+		{
+			size_t j = std::max(i + 1, blockBegin);
+
+#ifdef PARTICLE_KERNELS_X86
+			if (level == SimdLevel::AVX512)
+				j = overlapRowAvx512(particles, i, j, blockEnd, pairs);
+			else if (level == SimdLevel::AVX2)
+				j = overlapRowAvx2(particles, i, j, blockEnd, pairs);
+			else if (level == SimdLevel::SSE)
+				j = overlapRowSse(particles, i, j, blockEnd, pairs);
+#endif
+
+			overlapRowScalar(particles, i, j, blockEnd, pairs);
+		}
+	}
+}
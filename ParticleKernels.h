@@ -0,0 +1,109 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "ParticleStore.h"
+
+/**
+ * \enum SimdLevel
+ * \brief Setul de instructiuni vectoriale folosit de kernelurile pentru particule.
+ */
+enum class SimdLevel
+{
+    Scalar, ///< Fara instructiuni vectoriale, cate o particula pe iteratie.
+    SSE,    ///< SSE2, 4 particule pe iteratie.
+    AVX2,   ///< AVX2, 8 particule pe iteratie.
+    AVX512  ///< AVX-512F, 16 particule pe iteratie.
+};
+
+/**
+ * \class ParticleKernels
+ * \brief Kerneluri vectorizate care lucreaza direct pe vectorii din ParticleStore.
+ *
+ * Varianta vectoriala este aleasa la rulare in functie de procesor (dispatch dupa CPUID).
+ * Toate variantele executa aceleasi operatii in virgula mobila, in aceeasi ordine, ca varianta
+ * scalara, deci rezultatele sunt identice bit cu bit.
+ */
+class ParticleKernels
+{
+public:
+    /**
+     * \brief Detecteaza cel mai bun set de instructiuni suportat de procesor si de sistemul de operare.
+     * \return Setul de instructiuni detectat (rezultatul este calculat o singura data).
+     */
+    static SimdLevel detectSimdLevel();
+
+    /**
+     * \brief Returneaza numele unui set de instructiuni.
+     * \param level Setul de instructiuni.
+     * \return Numele setului de instructiuni.
+     */
+    static const char* simdLevelName(SimdLevel level);
+
+    /**
+     * \brief Integreaza pozitiile si reflecta directiile particulelor care au atins marginile cadrului.
+     *
+     * Echivalent cu `x += vx * deltaT; y += vy * deltaT;` urmat de ParticleStore::solveCollisionWithFrame
+     * pentru fiecare particula.
+     *
+     * \param particles Stocarea particulelor.
+     * \param deltaT Pasul de timp.
+     * \param frameWidth Latimea cadrului.
+     * \param frameHeight Inaltimea cadrului.
+     */
+    static void integrateAndReflect(ParticleStore& particles, float deltaT, int frameWidth, int frameHeight);
+
+    /**
+     * \brief La fel ca integrateAndReflect, dar cu un set de instructiuni ales explicit si pe un interval de particule.
+     *
+     * Daca setul cerut nu este suportat de procesor se foloseste cel mai bun set suportat care nu il depaseste.
+     *
+     * \param particles Stocarea particulelor.
+     * \param begin Primul ID din interval.
+     * \param end ID-ul de dupa ultimul din interval.
+     * \param deltaT Pasul de timp.
+     * \param frameWidth Latimea cadrului.
+     * \param frameHeight Inaltimea cadrului.
+     * \param level Setul de instructiuni dorit.
+     */
+    static void integrateAndReflect(ParticleStore& particles, size_t begin, size_t end, float deltaT, int frameWidth, int frameHeight, SimdLevel level);
+
+    /**
+     * \brief Testeaza toate perechile de particule (O(n^2)) si intoarce perechile de cercuri care se intersecteaza.
+     *
+     * Particulele sunt parcurse pe blocuri de ID-uri care incap in cache; fiecare particula este comparata cu cate
+     * 4/8/16 particule dintr-un bloc deodata. Testul este `dx * dx + dy * dy <= (r1 + r2)^2`, cu suma razelor marita
+     * foarte putin, ca sa nu fie ratata nicio pereche pe care CheckCollisionCircles o considera in coliziune
+     * (perechile sunt doar candidate, faza ingusta le testeaza din nou).
+     *
+     * \param particles Stocarea particulelor.
+     * \param pairs Vectorul golit si completat cu perechile (i, j), i < j.
+     */
+    static void findOverlappingPairs(const ParticleStore& particles, std::vector<std::pair<int, int>>& pairs);
+
+    /**
+     * \brief La fel ca findOverlappingPairs, dar cu un set de instructiuni ales explicit.
+     *
+     * Toate variantele dau aceleasi perechi, in aceeasi ordine. Daca setul cerut nu este suportat de procesor
+     * se foloseste cel mai bun set suportat care nu il depaseste.
+     *
+     * \param particles Stocarea particulelor.
+     * \param pairs Vectorul golit si completat cu perechile (i, j), i < j.
+     * \param level Setul de instructiuni dorit.
+     */
+    static void findOverlappingPairs(const ParticleStore& particles, std::vector<std::pair<int, int>>& pairs, SimdLevel level);
+
+    /**
+     * \brief La fel ca findOverlappingPairs, dar doar pentru perechile (i, j) cu i intr-un interval de ID-uri.
+     *
+     * Intervale disjuncte pot fi procesate in paralel; concatenate in ordinea intervalelor, rezultatele nu depind de
+     * felul in care a fost impartit [0, n) decat prin ordinea perechilor.
+     *
+     * \param particles Stocarea particulelor.
+     * \param firstBegin Primul ID i din interval.
+     * \param firstEnd ID-ul de dupa ultimul i din interval.
+     * \param pairs Vectorul golit si completat cu perechile (i, j), i < j.
+     * \param level Setul de instructiuni dorit.
+     */
+    static void findOverlappingPairs(const ParticleStore& particles, size_t firstBegin, size_t firstEnd, std::vector<std::pair<int, int>>& pairs, SimdLevel level);
+};
@@ -1,16 +1,23 @@
 #include "ParticleManager.h"
+#include <algorithm>
 #include <chrono>
-#include <typeinfo>
 #include <iostream>
 #include "Timer.h"
+#include "ParticleKernels.h"
 #define GRID_ROWS 50
 #define GRID_COLS 96
+#define INTEGRATE_GRAIN 4096
+#define BRUTE_FORCE_GRAIN 256
+#define QUADTREE_GRAIN 256
+#define SPATIAL_HASH_GRAIN 64
+#define SWEEP_AND_PRUNE_GRAIN 512
 
 ParticleManager::ParticleManager(int screenWidth, int screenHeight, MeasurementCollector& measurementCollector) :
 	screenWidth(screenWidth),
 	screenHeight(screenHeight),
 	measurementCollector(measurementCollector),
 	quadTreeParticles(Rectangle{ 0.f, 0.f, static_cast<float>(screenWidth), static_cast<float>(screenHeight) }, 0),
+	collisionSolver(threadPool),
 	algoState(Algo::QuadTree)
 {
 	randomGenerator = std::mt19937(randomDevice());
@@ -23,48 +30,73 @@ void ParticleManager::InitParticles(int numberOfParticles)
 
 	Timer h("InitParticles", measurementCollector, numberOfParticles);
 
-	particleMap.clear();
+	particles.clear();
 
-	allParticles.clear();
-
-	quadTreeParticles.clear();
+	quadTreeParticles.setOptions(quadTreeOptions);
 
 	bvhContainer.reset();
 
 	gridContainer.reset();
+	spatialHash.reset();
 
-
+	particles.reserve(numberOfParticles);
 	for (int i = 0; i < numberOfParticles; i++)
 		generateParticle();
 
-	for (auto elem : particleMap)
+	for (int id = 0; id < (int)particles.size(); id++)
 	{
-		int randomX = elem.second->getX();
-		int randomRadius = elem.second->getRadius();
-		int randomY = elem.second->getY();
-
-		Rectangle rect{ randomX - randomRadius, randomY - randomRadius, randomRadius * 2.f, randomRadius * 2.f };
-		quadTreeParticles.insert(elem.second, rect);
+		quadTreeParticles.insert(id, particles.getRectangle(id));
 	}
 
-	bvhContainer = std::make_unique<BvhContainer<Particle>>(particleMap);
+	bvhContainer = std::make_unique<BvhContainer<ParticleStore>>(particles, bvhOptions, &threadPool);
 	bvhContainer->buildBVH();
 
-	gridContainer = std::make_unique<GridContainer<Particle>>(GRID_ROWS, GRID_COLS, screenWidth, screenHeight);
-	for (auto elem : particleMap)
+	if (gridOptions.layout == GridLayout::SparseHash)
+	{
+		spatialHash = std::make_unique<SpatialHashContainer<ParticleStore>>(gridOptions);
+		spatialHash->update(particles);
+	}
+	else
 	{
-		gridContainer->insert(elem.second->getId(), elem.second->getX(), elem.second->getY());
+		gridContainer = std::make_unique<GridContainer<ParticleStore>>(GRID_ROWS, GRID_COLS, screenWidth, screenHeight, gridOptions);
+		gridContainer->update(particles);
 	}
+
+	sweepAndPrune.reset();
+	sweepAndPrune.update(particles);
+}
+
+void ParticleManager::setSeed(unsigned int seed)
+{
+	randomGenerator.seed(seed);
 }
 
 void ParticleManager::drawParticles()
 {
+	captureFrame(renderFrame);
+	renderFrame.draw();
+}
+
+void ParticleManager::captureFrame(RenderFrame& frame)
+{
+	frame.clear();
+	frame.x.assign(particles.x.begin(), particles.x.end());
+	frame.y.assign(particles.y.begin(), particles.y.end());
+	frame.radius.assign(particles.radius.begin(), particles.radius.end());
+
+	if (!onOffLines)
+		return;
+
 	if (algoState == Algo::QuadTree)
-		drawWithQuadTree();
+		addQuadTreeLines(frame);
 	else if (algoState == Algo::Grid)
-		drawWithGrid();
+		addGridLines(frame);
 	else if (algoState == Algo::BoundingVolume)
-		drawWithBvh();
+		addBvhLines(frame);
+	else if (algoState == Algo::SweepAndPrune)
+		addSweepAndPruneLines(frame);
+	else if (algoState == Algo::BruteForce)
+		addBruteForceLines(frame);
 }
 
 void ParticleManager::updateNumberOfParticles(int nParticles)
@@ -72,11 +104,24 @@ void ParticleManager::updateNumberOfParticles(int nParticles)
 	InitParticles(nParticles);
 }
 
-const StaticQuadTreeContainer<Particle>& ParticleManager::getQuadTreeParticles()
+const StaticQuadTreeContainer<ParticleStore>& ParticleManager::getQuadTreeParticles()
 {
 	return quadTreeParticles;
 }
 
+const ParticleStore& ParticleManager::getParticles() const
+{
+	return particles;
+}
+
+const std::vector<std::pair<int, int>>& ParticleManager::getContacts() const
+{
+	if (algoState == Algo::Grid && gridContainer && gridOptions.solveMode == GridSolveMode::ColoredCells)
+		return gridContacts;
+
+	return collisionSolver.getContacts();
+}
+
 void ParticleManager::updateParticles(float deltaT)
 {
 	if (algoState == Algo::QuadTree)
@@ -89,16 +134,22 @@ void ParticleManager::updateParticles(float deltaT)
 	{
 		updateWithBvh(deltaT);
 	}
+	else if (algoState == Algo::SweepAndPrune)
+	{
+		updateWithSweepAndPrune(deltaT);
+	}
+	else if (algoState == Algo::BruteForce)
+	{
+		updateWithBruteForce(deltaT);
+	}
 }
 
 void ParticleManager::updateParticleVelocity(float newVelocity)
 {
-	for (auto iter = quadTreeParticles.begin(); iter != quadTreeParticles.end(); ++iter)
+	for (int id = 0; id < (int)particles.size(); id++)
 	{
-		auto it = *iter;
-		Vector2 newDirection{ it->getDirection().x * newVelocity, it->getDirection().y * newVelocity };
-		it->setDirection(newDirection);
-		particleMap[it->getId()]->setDirection(newDirection);
+		particles.vx[id] *= newVelocity;
+		particles.vy[id] *= newVelocity;
 	}
 }
 
@@ -107,6 +158,11 @@ void ParticleManager::toggleLines()
 	onOffLines = !onOffLines;
 }
 
+void ParticleManager::setLineDepthLimit(int levels)
+{
+	lineDepthLimit = std::max(levels, 0);
+}
+
 void ParticleManager::startQuadTree()
 {
 	algoState = Algo::QuadTree;
@@ -122,6 +178,41 @@ void ParticleManager::startBoundingVolume()
 	algoState = Algo::BoundingVolume;
 }
 
+void ParticleManager::startSweepAndPrune()
+{
+	algoState = Algo::SweepAndPrune;
+}
+
+void ParticleManager::startBruteForce()
+{
+	algoState = Algo::BruteForce;
+}
+
+void ParticleManager::setBvhOptions(const BvhOptions& options)
+{
+	bvhOptions = options;
+}
+
+void ParticleManager::setQuadTreeOptions(const QuadTreeOptions& options)
+{
+	quadTreeOptions = options;
+}
+
+void ParticleManager::setGridOptions(const GridOptions& options)
+{
+	gridOptions = options;
+}
+
+void ParticleManager::setWorkerCount(size_t workerCount)
+{
+	threadPool.setWorkerCount(workerCount);
+}
+
+size_t ParticleManager::getThreadCount() const
+{
+	return threadPool.getThreadCount();
+}
+
 int ParticleManager::getScreenWidth()
 {
 	return screenWidth;
@@ -142,24 +233,30 @@ void ParticleManager::generateParticle()
 	float randomY = yDistrib(randomGenerator);
 	float randomRadius = radiusDistrib(randomGenerator);
 
-	std::shared_ptr<Particle> particlePtr = std::make_shared<Particle>(randomRadius, Vector2{ randomX, randomY });
-
-	particlePtr->setDirection(Vector2{ 3.0f, 3.0f });
+	particles.add(randomRadius, Vector2{ randomX, randomY }, Vector2{ 3.0f, 3.0f });
+}
 
-	std::pair<int, std::shared_ptr<Particle>> particlePair(particlePtr->getId(), particlePtr);
-	particleMap.insert(particlePair);
+void ParticleManager::integrateParticles(float deltaT)
+{
+	// fiecare particula este independenta, deci rezultatul nu depinde de impartirea pe bucati
+	SimdLevel level = ParticleKernels::detectSimdLevel();
+	threadPool.parallelFor(0, particles.size(), INTEGRATE_GRAIN, [&](size_t begin, size_t end)
+	{
+		ParticleKernels::integrateAndReflect(particles, begin, end, deltaT, screenWidth, screenHeight, level);
+	});
 }
 
-void ParticleManager::drawWithQuadTree()
+void ParticleManager::addQuadTreeLines(RenderFrame& frame)
 {
-	for (auto iter = quadTreeParticles.begin(); iter != quadTreeParticles.end(); ++iter)
+	auto addNode = [&](const Rectangle& rectangle)
 	{
-		auto it = *iter;
-		DrawCircle(it->getX(), it->getY(), it->getRadius(), it->getColor());
-	}
+		frame.addRectangleLines(rectangle);
+	};
 
-	if (onOffLines)
-		quadTreeParticles.drawLines();
+	if (lineDepthLimit > 0)
+		quadTreeParticles.forEachNodeRectangle(static_cast<size_t>(lineDepthLimit), addNode);
+	else
+		quadTreeParticles.forEachNodeRectangle(addNode);
 }
 
 void ParticleManager::updateWithQuadTree(float deltaT)
@@ -167,57 +264,52 @@ void ParticleManager::updateWithQuadTree(float deltaT)
 	measurementCollector.insertSize("updateWithQuadTree", quadTreeParticles.sizeOfDataStructure(), numberOfParticles);
 	Timer b("updateWithQuadTree", measurementCollector, numberOfParticles);
 
-	for (auto iter = quadTreeParticles.begin(); iter != quadTreeParticles.end(); ++iter)
-	{
-		auto it = *iter;
-		Particle* ptr = &*it;
+	integrateParticles(deltaT);
 
-		ptr->setX(ptr->getX() + 1 * ptr->getDirection().x * deltaT);
-		ptr->setY(ptr->getY() + 1 * ptr->getDirection().y * deltaT);
+	quadTreeParticles.update(particles);
 
-		ptr->solveCollisionWithFrame(screenWidth, screenHeight);
-	}
-
-	quadTreeParticles.update();
-
-	for (auto iter = quadTreeParticles.begin(); iter != quadTreeParticles.end(); ++iter)
+	// cautarile nu modifica arborele, deci se fac in paralel; fiecare pereche este pastrata doar de ID-ul mai mic
+	auto ids = quadTreeParticles.begin();
+	size_t count = quadTreeParticles.end() - ids;
+	candidateChunks.resize((count + QUADTREE_GRAIN - 1) / QUADTREE_GRAIN);
+	threadPool.parallelFor(0, count, QUADTREE_GRAIN, [&](size_t begin, size_t end)
 	{
-		auto it = *iter;
-		auto listOfPossibleParticleCollisions = quadTreeParticles.search(it->getRectangle());
-
-		for (const auto& particleIt : listOfPossibleParticleCollisions)
+		auto& pairs = candidateChunks[begin / QUADTREE_GRAIN];
+		pairs.clear();
+		for (size_t k = begin; k < end; k++)
 		{
-			auto particle = *particleIt;
-			if (CheckCollisionCircles(it->getPosition(), it->getRadius(), particle->getPosition(), particle->getRadius()))
+			int id = ids[k];
+			quadTreeParticles.forEachInArea(particles.getRectangle(id), [&](int other)
 			{
-				// elastic collision resolution
-				Particle* first = &*it;
-				Particle* second = &*particle;
-				first->circleElasticCollisionResolution(second);
-			}
+				if (id < other)
+					pairs.emplace_back(id, other);
+			});
 		}
-	}
+	});
+	addCandidateChunks(candidateChunks);
+
+	// elastic collision resolution
+	collisionSolver.solve(particles);
 }
 
-void ParticleManager::drawWithBvh()
+void ParticleManager::addBvhLines(RenderFrame& frame)
 {
-	for (auto elem : particleMap)
+	auto addNode = [&](const Node& elem)
+	{
+		frame.addRectangleLines(Rectangle{ elem.aabbMin.x, elem.aabbMin.y, elem.aabbMax.x - elem.aabbMin.x, elem.aabbMax.y - elem.aabbMin.y });
+	};
+
+	if (lineDepthLimit > 0)
 	{
-		DrawCircle(elem.second->getX(), elem.second->getY(), elem.second->getRadius(), elem.second->getColor());
+		bvhContainer->forEachNode(lineDepthLimit, addNode);
+		return;
 	}
 
-	if (onOffLines)
-		for (auto elem : bvhContainer->getBvhNodes())
-		{
-			int x0 = elem.aabbMin.x;
-			int y0 = elem.aabbMin.y;
-			int x1 = elem.aabbMax.x;
-			int y1 = elem.aabbMax.y;
-			DrawLine(x0, y0, x1, y0, GRAY);
-			DrawLine(x0, y0, x0, y1, GRAY);
-			DrawLine(x1, y0, x1, y1, GRAY);
-			DrawLine(x0, y1, x1, y1, GRAY);
-		}
+	// fara limita se parcurg nodurile in ordinea din memorie
+	const auto& nodes = bvhContainer->getBvhNodes();
+	frame.reserveLines(4 * static_cast<size_t>(bvhContainer->getNodesUsed()));
+	for (int i = 0; i < bvhContainer->getNodesUsed(); i++)
+		addNode(nodes[i]);
 }
 
 void ParticleManager::updateWithBvh(float deltaT)
@@ -225,105 +317,250 @@ void ParticleManager::updateWithBvh(float deltaT)
 	measurementCollector.insertSize("updateWithBvh", bvhContainer->sizeOfDataStructure(), numberOfParticles);
 	Timer d("updateWithBvh", measurementCollector, numberOfParticles);
 
-	for (auto it = particleMap.begin(); it != particleMap.end(); ++it)
-	{
-		Particle* ptr = &*(it->second);
+	integrateParticles(deltaT);
 
-		ptr->setX(ptr->getX() + 1 * ptr->getDirection().x * deltaT);
-		ptr->setY(ptr->getY() + 1 * ptr->getDirection().y * deltaT);
+	bvhContainer->update(deltaT, particles);
 
-		ptr->solveCollisionWithFrame(screenWidth, screenHeight);
-	}
+	auto colisions = bvhContainer->detectCollisions();
 
-	bvhContainer->update(deltaT, particleMap);
+	collisionSolver.clear();
+	for (auto colision : colisions)
+		collisionSolver.addCandidate(colision.first, colision.second);
 
-	if (!bvhContainer->detectCollisions().empty())
+	collisionSolver.solve(particles);
+}
+
+void ParticleManager::addGridLines(RenderFrame& frame)
+{
+	if (spatialHash)
 	{
-		auto colisions = bvhContainer->detectCollisions();
+		// reteaua rara are doar celulele ocupate
+		frame.reserveLines(4 * static_cast<size_t>(spatialHash->getCellCount()));
+		for (int cell = 0; cell < spatialHash->getCellCount(); cell++)
+			frame.addRectangleLines(spatialHash->getCellRectangle(cell));
+		return;
+	}
 
-		for (auto colision : colisions)
-		{
-			Particle* first = &(*particleMap[colision.first]);
-			Particle* second = &(*particleMap[colision.second]);
+	frame.reserveLines(gridContainer->getCols() + gridContainer->getRows());
+	float columnCoef = gridContainer->getCellWidth();
+	float rowCoef = gridContainer->getCellHeight();
+	for (int i = 0; i < gridContainer->getCols(); i++)
+		frame.addLine(Vector2{ i * columnCoef, 0.f }, Vector2{ i * columnCoef, static_cast<float>(screenHeight) });
 
-			first->circleElasticCollisionResolution(second);
-		}
-	}
+	for (int i = 0; i < gridContainer->getRows(); i++)
+		frame.addLine(Vector2{ 0.f, i * rowCoef }, Vector2{ static_cast<float>(screenWidth), i * rowCoef });
 }
 
-void ParticleManager::drawWithGrid()
+void ParticleManager::updateWithGrid(float deltaT)
 {
-	for (auto elem : particleMap)
+	if (spatialHash)
 	{
-		DrawCircle(elem.second->getX(), elem.second->getY(), elem.second->getRadius(), elem.second->getColor());
+		updateWithSpatialHash(deltaT);
+		return;
 	}
 
-	if (onOffLines)
+	measurementCollector.insertSize("updateWithGrid", gridContainer->sizeOfDataStructure(), numberOfParticles);
+	Timer f("updateWithGrid", measurementCollector, numberOfParticles);
+
+	integrateParticles(deltaT);
+
+	gridContainer->update(particles);
+	measurementCollector.insertParameter("gridRows", gridContainer->getRows(), numberOfParticles);
+	measurementCollector.insertParameter("gridCols", gridContainer->getCols(), numberOfParticles);
+	measurementCollector.insertParameter("gridCellWidth", gridContainer->getCellWidth(), numberOfParticles);
+	measurementCollector.insertParameter("gridCellHeight", gridContainer->getCellHeight(), numberOfParticles);
+	measurementCollector.insertParameter("gridReach", gridContainer->getReach(), numberOfParticles);
+
+	if (gridOptions.solveMode == GridSolveMode::ColoredCells)
 	{
-		int columnCoef = screenWidth / gridContainer->getCols();
-		int rowCoef = screenHeight / gridContainer->getRows();
-		for (int i = 0; i < GRID_COLS; i++)
-		{
-			int x0 = i * columnCoef;
-			int y0 = 0;
-			int x1 = i * columnCoef;
-			int y1 = screenHeight;
+		solveGridByColor();
+		return;
+	}
 
-			DrawLine(x0, y0, x1, y1, GRAY);
+	// fiecare pereche este formata de o singura celula, deci randurile se parcurg in paralel, cate un vector pe rand
+	int rows = gridContainer->getRows();
+	int cols = gridContainer->getCols();
+	candidateChunks.resize(rows);
+	threadPool.parallelFor(0, rows, 1, [&](size_t begin, size_t end)
+	{
+		for (size_t row = begin; row < end; row++)
+		{
+			auto& pairs = candidateChunks[row];
+			pairs.clear();
+			for (int col = 0; col < cols; col++)
+			{
+				gridContainer->forEachCandidatePairInCell(static_cast<int>(row), col, [&](int first, int second)
+				{
+					pairs.emplace_back(first, second);
+				});
+			}
 		}
+	});
+	addCandidateChunks(candidateChunks);
+
+	collisionSolver.solve(particles);
+}
 
-		for (int i = 0; i < GRID_ROWS; i++)
+void ParticleManager::solveGridByColor()
+{
+	int rows = gridContainer->getRows();
+	int cols = gridContainer->getCols();
+	int strideX = gridContainer->getColorStrideX();
+	int strideY = gridContainer->getColorStrideY();
+
+	// un vector de coliziuni pentru fiecare (rand, coloana de start), deci fiecare sarcina scrie doar in al ei
+	gridColorContacts.resize(static_cast<size_t>(rows) * strideX);
+	for (auto& contacts : gridColorContacts)
+		contacts.clear();
+
+	for (int color = 0; color < strideX * strideY; color++)
+	{
+		int firstRow = color / strideX;
+		int firstCol = color % strideX;
+		size_t colorRows = firstRow < rows ? (rows - firstRow + strideY - 1) / strideY : 0;
+
+		threadPool.parallelFor(0, colorRows, 1, [&](size_t begin, size_t end)
 		{
-			int x0 = 0;
-			int y0 = i * rowCoef;
-			int x1 = screenWidth;
-			int y1 = i * rowCoef;
+			for (size_t k = begin; k < end; k++)
+			{
+				int row = firstRow + static_cast<int>(k) * strideY;
+				auto& contacts = gridColorContacts[static_cast<size_t>(row) * strideX + firstCol];
 
-			DrawLine(x0, y0, x1, y1, GRAY);
-		}
+				for (int col = firstCol; col < cols; col += strideX)
+				{
+					gridContainer->forEachCandidatePairInCell(row, col, [&](int first, int second)
+					{
+						if (!CheckCollisionCircles(particles.getPosition(first), particles.radius[first], particles.getPosition(second), particles.radius[second]))
+							return;
+
+						Vector2 newFirst, newSecond;
+						particles.elasticCollisionResponse(first, second, newFirst, newSecond);
+						particles.vx[first] = newFirst.x;
+						particles.vy[first] = newFirst.y;
+						particles.vx[second] = newSecond.x;
+						particles.vy[second] = newSecond.y;
+
+						contacts.emplace_back(std::min(first, second), std::max(first, second));
+					});
+				}
+			}
+		});
 	}
+
+	gridContacts.clear();
+	for (const auto& contacts : gridColorContacts)
+		gridContacts.insert(gridContacts.end(), contacts.begin(), contacts.end());
+	std::sort(gridContacts.begin(), gridContacts.end());
+	measurementCollector.insertParameter("gridColors", strideX * strideY, numberOfParticles);
 }
 
-void ParticleManager::updateWithGrid(float deltaT)
+void ParticleManager::updateWithSpatialHash(float deltaT)
 {
-	measurementCollector.insertSize("updateWithGrid", gridContainer->sizeOfDataStructure(), numberOfParticles);
-	Timer f("updateWithGrid", measurementCollector, numberOfParticles);
+	measurementCollector.insertSize("updateWithSpatialHash", spatialHash->sizeOfDataStructure(), numberOfParticles);
+	Timer f("updateWithSpatialHash", measurementCollector, numberOfParticles);
+
+	integrateParticles(deltaT);
+
+	spatialHash->update(particles);
+	measurementCollector.insertParameter("spatialHashCells", spatialHash->getCellCount(), numberOfParticles);
+	measurementCollector.insertParameter("spatialHashCellSize", spatialHash->getCellSize(), numberOfParticles);
+	measurementCollector.insertParameter("spatialHashReach", spatialHash->getReach(), numberOfParticles);
 
-	for (auto it = particleMap.begin(); it != particleMap.end(); ++it)
+	size_t cellCount = spatialHash->getCellCount();
+	candidateChunks.resize((cellCount + SPATIAL_HASH_GRAIN - 1) / SPATIAL_HASH_GRAIN);
+	threadPool.parallelFor(0, cellCount, SPATIAL_HASH_GRAIN, [&](size_t begin, size_t end)
 	{
-		Particle* ptr = &*(it->second);
+		auto& pairs = candidateChunks[begin / SPATIAL_HASH_GRAIN];
+		pairs.clear();
+		for (size_t cell = begin; cell < end; cell++)
+		{
+			spatialHash->forEachCandidatePairInCell(static_cast<int>(cell), [&](int first, int second)
+			{
+				pairs.emplace_back(first, second);
+			});
+		}
+	});
+	addCandidateChunks(candidateChunks);
 
-		ptr->setX(ptr->getX() + 1 * ptr->getDirection().x * deltaT);
-		ptr->setY(ptr->getY() + 1 * ptr->getDirection().y * deltaT);
+	collisionSolver.solve(particles);
+}
 
-		ptr->solveCollisionWithFrame(screenWidth, screenHeight);
+void ParticleManager::addSweepAndPruneLines(RenderFrame& frame)
+{
+	// intervalul fiecarei particule pe axa de sortare
+	const auto& order = sweepAndPrune.getOrder();
+	frame.reserveLines(order.size());
+	for (int i = 0; i < (int)order.size(); i++)
+	{
+		Vector2 interval = sweepAndPrune.getInterval(i);
+		float y = particles.y[order[i]];
+		frame.addLine(Vector2{ interval.x, y }, Vector2{ interval.y, y });
 	}
+}
+
+void ParticleManager::updateWithSweepAndPrune(float deltaT)
+{
+	measurementCollector.insertSize("updateWithSweepAndPrune", sweepAndPrune.sizeOfDataStructure(), numberOfParticles);
+	Timer g("updateWithSweepAndPrune", measurementCollector, numberOfParticles);
+
+	integrateParticles(deltaT);
 
-	gridContainer->update(particleMap);
+	sweepAndPrune.update(particles);
+	measurementCollector.insertParameter("sweepAndPruneSwaps", sweepAndPrune.getMeanSwapCount(), numberOfParticles);
 
-	for (auto elem : particleMap)
+	// fiecare pereche este formata de pozitia mai mica din ordinea sortata, deci intervalele se parcurg in paralel
+	size_t count = sweepAndPrune.getOrder().size();
+	candidateChunks.resize((count + SWEEP_AND_PRUNE_GRAIN - 1) / SWEEP_AND_PRUNE_GRAIN);
+	threadPool.parallelFor(0, count, SWEEP_AND_PRUNE_GRAIN, [&](size_t begin, size_t end)
 	{
-		auto cellQuery = gridContainer->query(elem.second->getId());
-		if (!cellQuery.empty())
+		auto& pairs = candidateChunks[begin / SWEEP_AND_PRUNE_GRAIN];
+		pairs.clear();
+		sweepAndPrune.forEachCandidatePairInRange(static_cast<int>(begin), static_cast<int>(end), [&](int first, int second)
 		{
-			for (auto id : cellQuery)
-			{
-				if (id != elem.second->getId())
-				{
-					Particle* first = &*particleMap[id];
-					Particle* second = &*particleMap[elem.second->getId()];
+			pairs.emplace_back(first, second);
+		});
+	});
+	addCandidateChunks(candidateChunks);
 
-					Vector2 center1 = Vector2{ first->getX(), first->getY() };
-					float radius1 = particleMap[id]->getRadius();
-					Vector2 center2 = Vector2{ second->getX(), second->getY() };
-					float radius2 = particleMap[second->getId()]->getRadius();
+	collisionSolver.solve(particles);
+}
 
-					if (CheckCollisionCircles(center1, radius1, center2, radius2))
-					{
-						first->circleElasticCollisionResolution(second);
-					}
-				}
-			}
-		}
-	}
-}
\ No newline at end of file
+void ParticleManager::addBruteForceLines(RenderFrame& frame)
+{
+	// nu exista structura de desenat, deci se deseneaza perechile in coliziune
+	frame.reserveLines(getContacts().size());
+	for (const auto& contact : getContacts())
+		frame.addLine(particles.getPosition(contact.first), particles.getPosition(contact.second));
+}
+
+void ParticleManager::updateWithBruteForce(float deltaT)
+{
+	size_t pairsSize = 0;
+	for (const auto& chunk : bruteForcePairs)
+		pairsSize += chunk.capacity() * sizeof(std::pair<int, int>);
+	measurementCollector.insertSize("updateWithBruteForce", pairsSize, numberOfParticles);
+	Timer h("updateWithBruteForce", measurementCollector, numberOfParticles);
+
+	integrateParticles(deltaT);
+
+	// primele particule au cele mai multe perechi de testat, deci bucatile sunt mici si luate dinamic de fire
+	size_t count = particles.size();
+	bruteForcePairs.resize((count + BRUTE_FORCE_GRAIN - 1) / BRUTE_FORCE_GRAIN);
+	SimdLevel level = ParticleKernels::detectSimdLevel();
+	threadPool.parallelFor(0, count, BRUTE_FORCE_GRAIN, [&](size_t begin, size_t end)
+	{
+		ParticleKernels::findOverlappingPairs(particles, begin, end, bruteForcePairs[begin / BRUTE_FORCE_GRAIN], level);
+	});
+
+	addCandidateChunks(bruteForcePairs);
+
+	collisionSolver.solve(particles);
+}
+
+void ParticleManager::addCandidateChunks(const std::vector<std::vector<std::pair<int, int>>>& chunks)
+{
+	collisionSolver.clear();
+	for (const auto& chunk : chunks)
+		for (const auto& pair : chunk)
+			collisionSolver.addCandidate(pair.first, pair.second);
+}
@@ -2,15 +2,19 @@
 
 #include <vector>
 #include <raylib.h>
-#include "ParticleInterface.h"
-#include "Particle.h"
+#include "ParticleStore.h"
 #include "BvhContainer.h"
 #include <random>
 #include <memory>
 #include <utility>
 #include "QuadTreeContainer.h"
 #include "GridContainer.h"
+#include "SpatialHashContainer.h"
+#include "SweepAndPruneContainer.h"
 #include "MeasurementCollector.h"
+#include "ThreadPool.h"
+#include "CollisionSolver.h"
+#include "RenderFrame.h"
 
 
 /**
@@ -21,7 +25,9 @@ enum class Algo
 {
     QuadTree, ///< Algoritmul QuadTree.
     Grid,     ///< Algoritmul Grid.
-    BoundingVolume ///< Algoritmul de ierarhie a volumelor marginale.
+    BoundingVolume, ///< Algoritmul de ierarhie a volumelor marginale.
+    SweepAndPrune, ///< Algoritmul de sortare si baleiere pe o axa.
+    BruteForce ///< Testul vectorizat pe toate perechile, fara structura spatiala.
 };
 
 /**
@@ -51,11 +57,27 @@ public:
      */
     void InitParticles(int numberOfParticles);
 
+    /**
+     * \brief Seteaza samanta generatorului de particule.
+     *
+     * Doua apeluri InitParticles precedate de aceeasi samanta genereaza aceleasi particule.
+     *
+     * \param seed Samanta generatorului.
+     */
+    void setSeed(unsigned int seed);
+
     /**
      * \brief Deseneaza particulele.
      */
     void drawParticles();
 
+    /**
+     * \brief Copiaza particulele si liniile structurii algoritmului curent intr-un instantaneu de desenat.
+     *
+     * \param frame Instantaneul completat (memoria lui este refolosita).
+     */
+    void captureFrame(RenderFrame& frame);
+
     /**
      * \brief Actualizeaza numarul de particule.
      *
@@ -68,7 +90,21 @@ public:
      *
      * \return Particulele QuadTree.
      */
-    const StaticQuadTreeContainer<Particle>& getQuadTreeParticles();
+    const StaticQuadTreeContainer<ParticleStore>& getQuadTreeParticles();
+
+    /**
+     * \brief Obtine stocarea particulelor.
+     *
+     * \return Stocarea SoA a particulelor.
+     */
+    const ParticleStore& getParticles() const;
+
+    /**
+     * \brief Obtine perechile in coliziune gasite la ultima actualizare, sortate si fara duplicate.
+     *
+     * \return Perechile in coliziune.
+     */
+    const std::vector<std::pair<int, int>>& getContacts() const;
 
     /**
      * \brief Actualizeaza particulele.
@@ -89,6 +125,13 @@ public:
      */
     void toggleLines();
 
+    /**
+     * \brief Limiteaza numarul de niveluri ale arborelui (QuadTree sau BVH) desenate cand liniile sunt pornite.
+     *
+     * \param levels Numarul de niveluri desenate, incepand cu radacina (0 = toate nivelurile).
+     */
+    void setLineDepthLimit(int levels);
+
     /**
      * \brief Porneste algoritmul QuadTree.
      */
@@ -104,6 +147,53 @@ public:
      */
     void startBoundingVolume();
 
+    /**
+     * \brief Porneste algoritmul de sortare si baleiere (sweep and prune).
+     */
+    void startSweepAndPrune();
+
+    /**
+     * \brief Porneste testul pe toate perechile (forta bruta).
+     */
+    void startBruteForce();
+
+    /**
+     * \brief Seteaza parametrii containerului BVH. Se aplica la urmatorul apel InitParticles.
+     *
+     * \param options Parametrii de constructie si actualizare ai BVH.
+     */
+    void setBvhOptions(const BvhOptions& options);
+
+    /**
+     * \brief Seteaza parametrii containerului QuadTree. Se aplica la urmatorul apel InitParticles.
+     *
+     * \param options Parametrii QuadTree.
+     */
+    void setQuadTreeOptions(const QuadTreeOptions& options);
+
+    /**
+     * \brief Seteaza parametrii containerului Grid. Se aplica la urmatorul apel InitParticles.
+     *
+     * \param options Parametrii retelei.
+     */
+    void setGridOptions(const GridOptions& options);
+
+    /**
+     * \brief Seteaza numarul de fire suplimentare folosite pentru pasii paraleli ai fiecarui cadru.
+     *
+     * Firele raman pornite intre cadre; rezultatele simularii nu depind de numarul de fire.
+     *
+     * \param workerCount Numarul de fire suplimentare (0 = totul pe firul apelant).
+     */
+    void setWorkerCount(size_t workerCount);
+
+    /**
+     * \brief Obtine numarul total de fire care lucreaza la un cadru (firele suplimentare plus firul apelant).
+     *
+     * \return Numarul de fire.
+     */
+    size_t getThreadCount() const;
+
     /**
      * \brief Obtine latimea ecranului.
      *
@@ -125,9 +215,18 @@ private:
     void generateParticle();
 
     /**
-     * \brief Deseneaza particulele folosind algoritmul QuadTree.
+     * \brief Integreaza pozitiile tuturor particulelor si rezolva coliziunile cu marginile ecranului, in paralel.
+     *
+     * \param deltaT Pasul de timp pentru actualizare.
+     */
+    void integrateParticles(float deltaT);
+
+    /**
+     * \brief Adauga in instantaneu limitele nodurilor QuadTree.
+     *
+     * \param frame Instantaneul de completat.
      */
-    void drawWithQuadTree();
+    void addQuadTreeLines(RenderFrame& frame);
 
     /**
      * \brief Actualizeaza particulele folosind algoritmul QuadTree.
@@ -137,9 +236,11 @@ private:
     void updateWithQuadTree(float deltaT);
 
     /**
-     * \brief Deseneaza particulele folosind algoritmul de ierarhie a volumelor marginale.
+     * \brief Adauga in instantaneu volumele marginale ale nodurilor BVH.
+     *
+     * \param frame Instantaneul de completat.
      */
-    void drawWithBvh();
+    void addBvhLines(RenderFrame& frame);
 
     /**
      * \brief Actualizeaza particulele folosind algoritmul de ierarhie a volumelor marginale.
@@ -149,9 +250,11 @@ private:
     void updateWithBvh(float deltaT);
 
     /**
-     * \brief Deseneaza particulele folosind algoritmul Grid.
+     * \brief Adauga in instantaneu liniile retelei Grid (sau celulele ocupate ale retelei rare).
+     *
+     * \param frame Instantaneul de completat.
      */
-    void drawWithGrid();
+    void addGridLines(RenderFrame& frame);
 
     /**
      * \brief Actualizeaza particulele folosind algoritmul Grid.
@@ -160,21 +263,82 @@ private:
      */
     void updateWithGrid(float deltaT);
 
+    /**
+     * \brief Actualizeaza particulele folosind algoritmul Grid cu reteaua rara (GridLayout::SparseHash).
+     *
+     * \param deltaT Pasul de timp pentru actualizare.
+     */
+    void updateWithSpatialHash(float deltaT);
+
+    /**
+     * \brief Rezolva coliziunile din gridContainer pe culori de celule (GridSolveMode::ColoredCells).
+     *
+     * Culorile se proceseaza pe rand; celulele unei culori nu ating aceleasi particule, deci sunt impartite intre fire
+     * fara blocari, iar fiecare coliziune modifica imediat directiile particulelor. Rezultatul nu depinde de numarul de fire.
+     */
+    void solveGridByColor();
+
+    /**
+     * \brief Adauga in instantaneu intervalul fiecarei particule pe axa de sortare.
+     *
+     * \param frame Instantaneul de completat.
+     */
+    void addSweepAndPruneLines(RenderFrame& frame);
+
+    /**
+     * \brief Actualizeaza particulele folosind algoritmul de sortare si baleiere.
+     *
+     * \param deltaT Pasul de timp pentru actualizare.
+     */
+    void updateWithSweepAndPrune(float deltaT);
+
+    /**
+     * \brief Adauga in instantaneu perechile in coliziune gasite de testul pe toate perechile.
+     *
+     * \param frame Instantaneul de completat.
+     */
+    void addBruteForceLines(RenderFrame& frame);
+
+    /**
+     * \brief Actualizeaza particulele folosind testul pe toate perechile.
+     *
+     * \param deltaT Pasul de timp pentru actualizare.
+     */
+    void updateWithBruteForce(float deltaT);
+
+    /**
+     * \brief Goleste CollisionSolver si ii adauga perechile gasite in paralel, in ordinea bucatilor.
+     * \param chunks Perechile candidate, cate un vector pentru fiecare bucata de lucru.
+     */
+    void addCandidateChunks(const std::vector<std::vector<std::pair<int, int>>>& chunks);
+
     int screenWidth; ///< Latimea ecranului.
     int screenHeight; ///< Inaltimea ecranului.
     int numberOfParticles = 0;
 
-    std::list<std::shared_ptr<ParticleInterface>> allParticles; ///< Lista de toate particulele.
-    std::map<int, std::shared_ptr<Particle>> particleMap; ///< Harta a particulelor.
+    ParticleStore particles; ///< Stocarea SoA a tuturor particulelor, indexata dupa ID-ul dens.
 
-    StaticQuadTreeContainer<Particle> quadTreeParticles; ///< Container QuadTree pentru particule.
-    std::unique_ptr<BvhContainer<Particle>> bvhContainer; ///< Container de ierarhie a volumelor marginale pentru particule.
-    std::unique_ptr<GridContainer<Particle>> gridContainer; ///< Container Grid pentru particule.
+    StaticQuadTreeContainer<ParticleStore> quadTreeParticles; ///< Container QuadTree pentru particule.
+    QuadTreeOptions quadTreeOptions; ///< Parametrii containerului QuadTree.
+    std::unique_ptr<BvhContainer<ParticleStore>> bvhContainer; ///< Container de ierarhie a volumelor marginale pentru particule.
+    BvhOptions bvhOptions; ///< Parametrii containerului BVH.
+    std::unique_ptr<GridContainer<ParticleStore>> gridContainer; ///< Container Grid pentru particule.
+    std::unique_ptr<SpatialHashContainer<ParticleStore>> spatialHash; ///< Reteaua rara, folosita in locul gridContainer cu GridLayout::SparseHash.
+    GridOptions gridOptions; ///< Parametrii containerului Grid.
+    std::vector<std::vector<std::pair<int, int>>> gridColorContacts; ///< Coliziunile gasite de solveGridByColor, cate un vector pentru fiecare (rand, coloana de start) procesat.
+    std::vector<std::pair<int, int>> gridContacts; ///< Coliziunile gasite de solveGridByColor la ultimul cadru, sortate.
+    SweepAndPruneContainer<ParticleStore> sweepAndPrune; ///< Particulele sortate pe axa X pentru sortare si baleiere.
+    std::vector<std::vector<std::pair<int, int>>> candidateChunks; ///< Perechile candidate gasite in paralel de QuadTree, Grid, SpatialHash si SweepAndPrune, cate un vector pentru fiecare bucata, refolosite intre cadre.
+    std::vector<std::vector<std::pair<int, int>>> bruteForcePairs; ///< Perechile gasite de testul pe toate perechile, cate un vector pentru fiecare bucata de ID-uri, refolosite intre cadre.
+    ThreadPool threadPool; ///< Firele de executie folosite pentru pasii paraleli.
+    CollisionSolver collisionSolver; ///< Faza ingusta: rezolva perechile candidate gasite de container.
     MeasurementCollector& measurementCollector;
+    RenderFrame renderFrame; ///< Instantaneul folosit de drawParticles, refolosit intre cadre.
 
     std::random_device randomDevice; ///< Dispozitiv random pentru generarea particulelor.
     std::mt19937 randomGenerator; ///< Generator random pentru generarea particulelor.
 
     bool onOffLines; ///< Indicator pentru afisarea liniilor pentru particule.
+    int lineDepthLimit = 0; ///< Numarul de niveluri ale arborelui desenate cand liniile sunt pornite (0 = toate).
     Algo algoState; ///< Starea algoritmului curent.
 };
@@ -0,0 +1,296 @@
+#include "ParticleRenderer.h"
+#include <algorithm>
+#include "rlgl.h"
+#include "raymath.h"
+
+#define SPRITE_TEXTURE_SIZE 64
+#define SPRITE_BATCH 1024
+#define LINE_BATCH 4096
+#define INITIAL_INSTANCE_CAPACITY 1024
+
+namespace
+{
+	// instanceData = (x, y, raza); patrulaterul [-1, 1] x [-1, 1] este scalat cu raza si mutat in centru
+	const char* circleVertexShader = R"(#version 330
+in vec2 vertexPosition;
+in vec3 instanceData;
+uniform mat4 mvp;
+out vec2 fragOffset;
+void main()
+{
+    fragOffset = vertexPosition;
+    gl_Position = mvp * vec4(instanceData.xy + vertexPosition * instanceData.z, 0.0, 1.0);
+}
+)";
+
+	const char* circleFragmentShader = R"(#version 330
+in vec2 fragOffset;
+uniform vec4 color;
+out vec4 finalColor;
+void main()
+{
+    if (dot(fragOffset, fragOffset) > 1.0)
+        discard;
+    finalColor = color;
+}
+)";
+
+	// instanceData = (inceput, sfarsit); patrulaterul [0, 1] x [-0.5, 0.5] este intins de-a lungul liniei, cu latimea de un pixel
+	const char* lineVertexShader = R"(#version 330
+in vec2 vertexPosition;
+in vec4 instanceData;
+uniform mat4 mvp;
+void main()
+{
+    vec2 direction = instanceData.zw - instanceData.xy;
+    float len = length(direction);
+    vec2 along = len > 0.0 ? direction / len : vec2(1.0, 0.0);
+    vec2 across = vec2(-along.y, along.x);
+    gl_Position = mvp * vec4(instanceData.xy + direction * vertexPosition.x + across * vertexPosition.y, 0.0, 1.0);
+}
+)";
+
+	const char* lineFragmentShader = R"(#version 330
+uniform vec4 color;
+out vec4 finalColor;
+void main()
+{
+    finalColor = color;
+}
+)";
+
+	// doua triunghiuri care acopera patratul [-1, 1] x [-1, 1]
+	const float circleQuad[] = { -1.f, -1.f, 1.f, -1.f, 1.f, 1.f, -1.f, -1.f, 1.f, 1.f, -1.f, 1.f };
+
+	// doua triunghiuri care acopera dreptunghiul [0, 1] x [-0.5, 0.5]
+	const float lineQuad[] = { 0.f, -0.5f, 1.f, -0.5f, 1.f, 0.5f, 0.f, -0.5f, 1.f, 0.5f, 0.f, 0.5f };
+}
+
+bool ParticleRenderer::InstancedBatch::load(const char* vertexShader, const char* fragmentShader, const float* quad, int components)
+{
+	// la esecul compilarii rlgl intoarce shaderul implicit
+	shader = rlLoadShaderCode(vertexShader, fragmentShader);
+	if (shader == 0 || shader == rlGetShaderIdDefault())
+		return false;
+
+	mvpLocation = rlGetLocationUniform(shader, "mvp");
+	colorLocation = rlGetLocationUniform(shader, "color");
+	instanceLocation = rlGetLocationAttrib(shader, "instanceData");
+	int positionLocation = rlGetLocationAttrib(shader, "vertexPosition");
+
+	vertexArray = rlLoadVertexArray();
+	if (vertexArray == 0 || instanceLocation < 0 || positionLocation < 0)
+	{
+		if (vertexArray != 0)
+			rlUnloadVertexArray(vertexArray);
+		rlUnloadShaderProgram(shader);
+		return false;
+	}
+
+	this->components = components;
+	rlEnableVertexArray(vertexArray);
+
+	quadBuffer = rlLoadVertexBuffer(quad, 12 * sizeof(float), false);
+	rlSetVertexAttribute(positionLocation, 2, RL_FLOAT, false, 0, 0);
+	rlEnableVertexAttribute(positionLocation);
+
+	capacity = INITIAL_INSTANCE_CAPACITY;
+	instanceBuffer = rlLoadVertexBuffer(nullptr, (int)(capacity * components * sizeof(float)), true);
+	rlSetVertexAttribute(instanceLocation, components, RL_FLOAT, false, 0, 0);
+	rlEnableVertexAttribute(instanceLocation);
+	rlSetVertexAttributeDivisor(instanceLocation, 1);
+
+	rlDisableVertexArray();
+	loaded = true;
+
+	return true;
+}
+
+void ParticleRenderer::InstancedBatch::draw(const float* data, size_t count, Color color)
+{
+	if (count == 0)
+		return;
+
+	// ce a fost adaugat inainte in lotul raylib (fundalul, meniul) trebuie desenat inaintea instantelor
+	rlDrawRenderBatchActive();
+
+	rlEnableVertexArray(vertexArray);
+	if (count > capacity)
+	{
+		// bufferul nou trebuie legat din nou de atributul de instanta
+		rlUnloadVertexBuffer(instanceBuffer);
+		capacity = std::max(count, 2 * capacity);
+		instanceBuffer = rlLoadVertexBuffer(nullptr, (int)(capacity * components * sizeof(float)), true);
+		rlSetVertexAttribute(instanceLocation, components, RL_FLOAT, false, 0, 0);
+		rlEnableVertexAttribute(instanceLocation);
+		rlSetVertexAttributeDivisor(instanceLocation, 1);
+	}
+	rlUpdateVertexBuffer(instanceBuffer, data, (int)(count * components * sizeof(float)), 0);
+
+	float normalizedColor[4] = { color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f };
+	rlEnableShader(shader);
+	rlSetUniformMatrix(mvpLocation, MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection()));
+	rlSetUniform(colorLocation, normalizedColor, RL_SHADER_UNIFORM_VEC4, 1);
+
+	rlDrawVertexArrayInstanced(0, 6, (int)count);
+
+	rlDisableShader();
+	rlDisableVertexArray();
+}
+
+void ParticleRenderer::InstancedBatch::unload()
+{
+	if (!loaded)
+		return;
+
+	rlUnloadVertexArray(vertexArray);
+	rlUnloadVertexBuffer(quadBuffer);
+	rlUnloadVertexBuffer(instanceBuffer);
+	rlUnloadShaderProgram(shader);
+	capacity = 0;
+	loaded = false;
+}
+
+void ParticleRenderer::setMode(ParticleRenderMode mode)
+{
+	this->mode = mode;
+}
+
+ParticleRenderMode ParticleRenderer::getMode() const
+{
+	return mode;
+}
+
+void ParticleRenderer::draw(const RenderFrame& frame)
+{
+	if (mode == ParticleRenderMode::Instanced && !circles.loaded)
+		loadInstanced();
+	if (mode == ParticleRenderMode::Sprites && !spritesLoaded)
+		loadSprites();
+
+	if (mode == ParticleRenderMode::Instanced)
+	{
+		drawInstanced(frame);
+		if (!frame.lines.empty())
+			lines.draw(&frame.lines[0].x, frame.lines.size() / 2, GRAY);
+	}
+	else if (mode == ParticleRenderMode::Sprites)
+	{
+		drawSprites(frame);
+		drawBatchedLines(frame);
+	}
+	else
+	{
+		frame.draw();
+	}
+}
+
+void ParticleRenderer::unload()
+{
+	circles.unload();
+	lines.unload();
+
+	if (spritesLoaded)
+	{
+		UnloadTexture(circleTexture);
+		spritesLoaded = false;
+	}
+}
+
+void ParticleRenderer::loadInstanced()
+{
+	int version = rlGetVersion();
+	bool supported = version == RL_OPENGL_33 || version == RL_OPENGL_43;
+
+	if (supported && circles.load(circleVertexShader, circleFragmentShader, circleQuad, 3) &&
+		lines.load(lineVertexShader, lineFragmentShader, lineQuad, 4))
+		return;
+
+	circles.unload();
+	mode = ParticleRenderMode::Sprites;
+}
+
+void ParticleRenderer::loadSprites()
+{
+	Image image = GenImageColor(SPRITE_TEXTURE_SIZE, SPRITE_TEXTURE_SIZE, BLANK);
+	ImageDrawCircle(&image, SPRITE_TEXTURE_SIZE / 2, SPRITE_TEXTURE_SIZE / 2, SPRITE_TEXTURE_SIZE / 2 - 1, WHITE);
+	circleTexture = LoadTextureFromImage(image);
+	UnloadImage(image);
+
+	SetTextureFilter(circleTexture, TEXTURE_FILTER_BILINEAR);
+	spritesLoaded = true;
+}
+
+void ParticleRenderer::drawInstanced(const RenderFrame& frame)
+{
+	size_t count = frame.x.size();
+
+	instanceData.resize(count * 3);
+	for (size_t id = 0; id < count; id++)
+	{
+		instanceData[3 * id] = frame.x[id];
+		instanceData[3 * id + 1] = frame.y[id];
+		instanceData[3 * id + 2] = frame.radius[id];
+	}
+
+	circles.draw(instanceData.data(), count, BLACK);
+}
+
+void ParticleRenderer::drawSprites(const RenderFrame& frame)
+{
+	size_t count = frame.x.size();
+
+	for (size_t begin = 0; begin < count; begin += SPRITE_BATCH)
+	{
+		size_t end = std::min(count, begin + SPRITE_BATCH);
+
+		// lotul raylib se goleste intre doua bucati, nu in mijlocul uneia
+		rlCheckRenderBatchLimit((int)(4 * (end - begin)));
+		rlSetTexture(circleTexture.id);
+		rlBegin(RL_QUADS);
+		rlColor4ub(0, 0, 0, 255);
+
+		for (size_t id = begin; id < end; id++)
+		{
+			float left = frame.x[id] - frame.radius[id];
+			float right = frame.x[id] + frame.radius[id];
+			float top = frame.y[id] - frame.radius[id];
+			float bottom = frame.y[id] + frame.radius[id];
+
+			rlTexCoord2f(0.f, 0.f);
+			rlVertex2f(left, top);
+			rlTexCoord2f(0.f, 1.f);
+			rlVertex2f(left, bottom);
+			rlTexCoord2f(1.f, 1.f);
+			rlVertex2f(right, bottom);
+			rlTexCoord2f(1.f, 0.f);
+			rlVertex2f(right, top);
+		}
+
+		rlEnd();
+		rlSetTexture(0);
+	}
+}
+
+void ParticleRenderer::drawBatchedLines(const RenderFrame& frame)
+{
+	size_t count = frame.lines.size();
+	Color color = GRAY;
+
+	for (size_t begin = 0; begin < count; begin += 2 * LINE_BATCH)
+	{
+		size_t end = std::min(count, begin + 2 * LINE_BATCH);
+
+		rlCheckRenderBatchLimit((int)(end - begin));
+		rlBegin(RL_LINES);
+		rlColor4ub(color.r, color.g, color.b, color.a);
+
+		for (size_t i = begin; i + 1 < end; i += 2)
+		{
+			rlVertex2f(frame.lines[i].x, frame.lines[i].y);
+			rlVertex2f(frame.lines[i + 1].x, frame.lines[i + 1].y);
+		}
+
+		rlEnd();
+	}
+}
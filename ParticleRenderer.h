@@ -0,0 +1,144 @@
+#pragma once
+#include <vector>
+#include "raylib.h"
+#include "RenderFrame.h"
+
+/**
+ * \enum ParticleRenderMode
+ * \brief Modul in care ParticleRenderer deseneaza cercurile particulelor.
+ */
+enum class ParticleRenderMode
+{
+    Circles,    ///< Cate un DrawCircle pentru fiecare particula (un evantai de triunghiuri construit pe procesor).
+    Sprites,    ///< Cate un patrulater pentru fiecare particula, cu aceeasi textura de cerc, adaugate in lotul raylib.
+    Instanced   ///< Un singur apel instantiat: un patrulater comun si un buffer cu (x, y, raza) pentru fiecare particula.
+};
+
+/**
+ * \class ParticleRenderer
+ * \brief Deseneaza un RenderFrame cu cat mai putine varfuri si apeluri de desenare.
+ *
+ * In modul Instanced, pozitiile si razele sunt copiate intr-un singur buffer de instante (12 bytes pe particula), iar
+ * toate cercurile sunt desenate cu un singur apel: shaderul de varfuri scaleaza si muta patrulaterul comun pentru
+ * fiecare instanta, iar shaderul de fragmente arunca pixelii din afara cercului. Cand contextul OpenGL nu permite
+ * desenarea instantiata (OpenGL 2.1 / ES 2.0) se foloseste modul Sprites: cate un patrulater texturat pe particula,
+ * construit pe procesor, dar desenat tot in loturi mari (4 varfuri pe particula, fata de zeci pentru DrawCircle).
+ *
+ * Liniile structurii algoritmului sunt desenate la fel: in modul Instanced bufferul RenderFrame::lines este copiat
+ * o singura data in bufferul de instante al liniilor si desenat cu un singur apel, in care fiecare linie devine un
+ * dreptunghi subtire; in modul Sprites sunt adaugate in lotul raylib in bucati mari.
+ *
+ * Resursele grafice sunt create la primul draw(), deci obiectul poate fi construit inainte de InitWindow, si trebuie
+ * eliberate cu unload() inainte de CloseWindow.
+ */
+class ParticleRenderer
+{
+public:
+    ParticleRenderer() = default;
+    ParticleRenderer(const ParticleRenderer&) = delete;
+    ParticleRenderer& operator=(const ParticleRenderer&) = delete;
+
+    /**
+     * \brief Alege modul de desenare a cercurilor.
+     *
+     * Daca modul Instanced nu este suportat de contextul grafic, la primul draw() se trece la Sprites.
+     * \param mode Modul cerut.
+     */
+    void setMode(ParticleRenderMode mode);
+
+    /**
+     * \brief Obtine modul de desenare folosit.
+     * \return Modul curent.
+     */
+    ParticleRenderMode getMode() const;
+
+    /**
+     * \brief Deseneaza particulele si liniile unui instantaneu.
+     * \param frame Instantaneul de desenat.
+     */
+    void draw(const RenderFrame& frame);
+
+    /**
+     * \brief Elibereaza shaderul, bufferele si textura (trebuie apelat cat timp fereastra este deschisa).
+     */
+    void unload();
+
+private:
+    /**
+     * \struct InstancedBatch
+     * \brief Un shader, un patrulater comun si un buffer de instante, desenate cu un singur apel instantiat.
+     */
+    struct InstancedBatch
+    {
+        /**
+         * \brief Compileaza shaderele si creeaza bufferele.
+         * \param vertexShader Codul shaderului de varfuri (atributele vertexPosition si instanceData, uniforma mvp).
+         * \param fragmentShader Codul shaderului de fragmente (uniforma color).
+         * \param quad Cele sase varfuri (x, y) ale patrulaterului comun.
+         * \param components Numarul de valori float ale fiecarei instante.
+         * \return `true` daca resursele au fost create.
+         */
+        bool load(const char* vertexShader, const char* fragmentShader, const float* quad, int components);
+
+        /**
+         * \brief Copiaza instantele in buffer si le deseneaza cu un singur apel.
+         * \param data Instantele, cate components valori float fiecare.
+         * \param count Numarul de instante.
+         * \param color Culoarea desenului.
+         */
+        void draw(const float* data, size_t count, Color color);
+
+        /**
+         * \brief Elibereaza shaderul si bufferele.
+         */
+        void unload();
+
+        bool loaded = false;                ///< Indicator pentru resursele create.
+        unsigned int shader = 0;            ///< Programul cu shaderele de varfuri si fragmente.
+        int mvpLocation = -1;               ///< Locatia matricei model-vedere-proiectie in shader.
+        int colorLocation = -1;             ///< Locatia culorii in shader.
+        int instanceLocation = -1;          ///< Locatia atributului de instanta in shader.
+        int components = 0;                 ///< Numarul de valori float ale fiecarei instante.
+        unsigned int vertexArray = 0;       ///< Obiectul care leaga bufferul patrulaterului si bufferul de instante.
+        unsigned int quadBuffer = 0;        ///< Cele sase varfuri ale patrulaterului comun.
+        unsigned int instanceBuffer = 0;    ///< Bufferul de instante.
+        size_t capacity = 0;                ///< Numarul de instante care incap in instanceBuffer.
+    };
+
+    /**
+     * \brief Creeaza resursele pentru desenarea instantiata; la esec trece la modul Sprites.
+     */
+    void loadInstanced();
+
+    /**
+     * \brief Creeaza textura cercului folosita de modul Sprites.
+     */
+    void loadSprites();
+
+    /**
+     * \brief Deseneaza toate cercurile cu un singur apel instantiat.
+     * \param frame Instantaneul de desenat.
+     */
+    void drawInstanced(const RenderFrame& frame);
+
+    /**
+     * \brief Deseneaza cercurile ca patrulatere texturate, in loturi.
+     * \param frame Instantaneul de desenat.
+     */
+    void drawSprites(const RenderFrame& frame);
+
+    /**
+     * \brief Adauga liniile in lotul raylib, in bucati mari, in loc de cate un DrawLine pentru fiecare.
+     * \param frame Instantaneul de desenat.
+     */
+    void drawBatchedLines(const RenderFrame& frame);
+
+    ParticleRenderMode mode = ParticleRenderMode::Instanced;  ///< Modul de desenare.
+
+    InstancedBatch circles;             ///< Cercurile: cate (x, y, raza) pentru fiecare particula.
+    InstancedBatch lines;               ///< Liniile: cate (inceput, sfarsit) pentru fiecare linie, luate direct din RenderFrame::lines.
+    std::vector<float> instanceData;    ///< Datele de instanta ale cercurilor, intercalate, refolosite intre cadre.
+
+    bool spritesLoaded = false;         ///< Indicator pentru textura modului Sprites.
+    Texture2D circleTexture{};          ///< Textura unui cerc alb pe fond transparent.
+};
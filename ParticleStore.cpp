@@ -0,0 +1,152 @@
+#include "ParticleStore.h"
+#include <cmath>
+
+int ParticleStore::add(float particleRadius, Vector2 position, Vector2 direction)
+{
+	x.push_back(position.x);
+	y.push_back(position.y);
+	vx.push_back(direction.x);
+	vy.push_back(direction.y);
+	radius.push_back(particleRadius);
+	mass.push_back(2 * particleRadius);
+
+	return static_cast<int>(x.size()) - 1;
+}
+
+void ParticleStore::clear()
+{
+	x.clear();
+	y.clear();
+	vx.clear();
+	vy.clear();
+	radius.clear();
+	mass.clear();
+}
+
+void ParticleStore::reserve(size_t count)
+{
+	x.reserve(count);
+	y.reserve(count);
+	vx.reserve(count);
+	vy.reserve(count);
+	radius.reserve(count);
+	mass.reserve(count);
+}
+
+size_t ParticleStore::size() const
+{
+	return x.size();
+}
+
+Vector2 ParticleStore::getPosition(int id) const
+{
+	return Vector2{ x[id], y[id] };
+}
+
+Rectangle ParticleStore::getRectangle(int id) const
+{
+	return Rectangle{ x[id] - radius[id], y[id] - radius[id], 2 * radius[id], 2 * radius[id] };
+}
+
+void ParticleStore::solveCollisionWithFrame(int id, int screenWidth, int screenHeight)
+{
+	// if it hits the bottom
+	if (y[id] + radius[id] > screenHeight)
+	{
+		if (vx[id] > 0 && vy[id] > 0)
+		{
+			vx[id] = 3.0f;
+			vy[id] = -3.0f;
+		}
+		else if (vx[id] < 0 && vy[id] > 0)
+		{
+			vx[id] = -3.0f;
+			vy[id] = -3.0f;
+		}
+	}
+
+	// if it hits the left side
+	if (x[id] - radius[id] < 0)
+	{
+		if (vx[id] < 0 && vy[id] < 0)
+		{
+			vx[id] = 3.0f;
+			vy[id] = -3.0f;
+		}
+		else if (vx[id] < 0 && vy[id] > 0)
+		{
+			vx[id] = 3.0f;
+			vy[id] = 3.0f;
+		}
+	}
+
+	// if it hits the right side
+	if (x[id] + radius[id] > screenWidth)
+	{
+		if (vx[id] > 0 && vy[id] > 0)
+		{
+			vx[id] = -3.0f;
+			vy[id] = 3.0f;
+		}
+		else if (vx[id] > 0 && vy[id] < 0)
+		{
+			vx[id] = -3.0f;
+			vy[id] = -3.0f;
+		}
+	}
+
+	// if it hits the top
+	if (y[id] - radius[id] < 0)
+	{
+		if (vx[id] > 0 && vy[id] < 0)
+		{
+			vx[id] = 3.0f;
+			vy[id] = 3.0f;
+		}
+		else if (vx[id] < 0 && vy[id] < 0)
+		{
+			vx[id] = -3.0f;
+			vy[id] = 3.0f;
+		}
+	}
+}
+
+void ParticleStore::elasticCollisionResponse(int first, int second, Vector2& newFirst, Vector2& newSecond) const
+{
+	newFirst = Vector2{ vx[first], vy[first] };
+	newSecond = Vector2{ vx[second], vy[second] };
+
+	float distance = sqrt((x[first] - x[second]) * (x[first] - x[second]) + (y[first] - y[second]) * (y[first] - y[second]));
+
+	// centre identice: nu exista o normala de coliziune
+	if (first == second || distance == 0.f)
+		return;
+
+	float normalX = (x[second] - x[first]) / distance;
+	float normalY = (y[second] - y[first]) / distance;
+
+	float tangentX = -normalY;
+	float tangentY = normalX;
+
+	float dpTangent1 = vx[first] * tangentX + vy[first] * tangentY;
+	float dpTangent2 = vx[second] * tangentX + vy[second] * tangentY;
+
+	float dpNormal1 = vx[first] * normalX + vy[first] * normalY;
+	float dpNormal2 = vx[second] * normalX + vy[second] * normalY;
+
+	// particulele se departeaza deja una de alta
+	if (dpNormal1 - dpNormal2 <= 0.f)
+		return;
+
+	// conservation of momentum
+	float m1 = (dpNormal1 * (mass[first] - mass[second]) + 2.0f * mass[second] * dpNormal2) / (mass[first] + mass[second]);
+	float m2 = (dpNormal2 * (mass[second] - mass[first]) + 2.0f * mass[first] * dpNormal1) / (mass[first] + mass[second]);
+
+	newFirst = Vector2{ tangentX * dpTangent1 + normalX * m1, tangentY * dpTangent1 + normalY * m1 };
+	newSecond = Vector2{ tangentX * dpTangent2 + normalX * m2, tangentY * dpTangent2 + normalY * m2 };
+}
+
+size_t ParticleStore::sizeOfDataStructure() const
+{
+	return (x.size() + y.size() + vx.size() + vy.size() + radius.size() + mass.size()) * sizeof(float);
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <vector>
+#include "raylib.h"
+
+/**
+ * \struct ParticleStore
+ * \brief Stocarea particulelor sub forma de structura de vectori (SoA).
+ *
+ * Fiecare proprietate a particulelor este stocata intr-un vector contiguu, indexat dupa ID-ul dens
+ * al particulei (0 .. size() - 1). Containerele (QuadTree, Grid, BVH) citesc direct acesti vectori,
+ * iar integrarea si rezolvarea coliziunilor devin parcurgeri liniare, fara apeluri virtuale.
+ */
+struct ParticleStore
+{
+    std::vector<float> x;       ///< Coordonatele X ale pozitiilor.
+    std::vector<float> y;       ///< Coordonatele Y ale pozitiilor.
+    std::vector<float> vx;      ///< Componentele X ale directiilor.
+    std::vector<float> vy;      ///< Componentele Y ale directiilor.
+    std::vector<float> radius;  ///< Razele particulelor.
+    std::vector<float> mass;    ///< Masele particulelor.
+
+    /**
+     * \brief Adauga o particula.
+     * \param particleRadius Raza particulei.
+     * \param position Pozitia particulei.
+     * \param direction Directia particulei.
+     * \return ID-ul dens al particulei adaugate.
+     */
+    int add(float particleRadius, Vector2 position, Vector2 direction);
+
+    /**
+     * \brief Elimina toate particulele.
+     */
+    void clear();
+
+    /**
+     * \brief Rezerva memorie pentru un numar de particule.
+     * \param count Numarul de particule.
+     */
+    void reserve(size_t count);
+
+    /**
+     * \brief Returneaza numarul de particule.
+     * \return Numarul de particule.
+     */
+    size_t size() const;
+
+    /**
+     * \brief Obtine pozitia unei particule.
+     * \param id ID-ul particulei.
+     * \return Vectorul de pozitie al particulei.
+     */
+    Vector2 getPosition(int id) const;
+
+    /**
+     * \brief Obtine reprezentarea sub forma de dreptunghi a unei particule.
+     * \param id ID-ul particulei.
+     * \return Dreptunghiul care reprezinta particula.
+     */
+    Rectangle getRectangle(int id) const;
+
+    /**
+     * \brief Rezolva coliziunea intre o particula si cadrul cu dimensiunile specificate.
+     * \param id ID-ul particulei.
+     * \param frameWidth Latimea cadrului.
+     * \param frameHeight Inaltimea cadrului.
+     */
+    void solveCollisionWithFrame(int id, int frameWidth, int frameHeight);
+
+    /**
+     * \brief Calculeaza directiile dupa coliziunea elastica intre doua particule, fara a le modifica.
+     * \param first ID-ul primei particule.
+     * \param second ID-ul celei de-a doua particule.
+     * \param newFirst Directia primei particule dupa coliziune.
+     * \param newSecond Directia celei de-a doua particule dupa coliziune.
+     */
+    void elasticCollisionResponse(int first, int second, Vector2& newFirst, Vector2& newSecond) const;
+
+    /**
+     * \brief Calculeaza locul ocupat in memorie de vectorii particulelor.
+     * \return Numarul de bytes ocupati.
+     */
+    size_t sizeOfDataStructure() const;
+};
@@ -2,25 +2,86 @@
 #include <raylib.h>
 #include <vector>
 #include <array>
-#include <memory>
-#include <list>
+#include <cstdint>
+#include <algorithm>
+
+/**
+ * \enum QuadTreeUpdateMode
+ * \brief Modul in care StaticQuadTreeContainer::update actualizeaza arborele la fiecare cadru.
+ */
+enum class QuadTreeUpdateMode
+{
+    Rebuild,    ///< Goleste arborele si reinsereaza toate elementele.
+    Incremental ///< Muta doar elementele care au iesit din limitele nodului lor.
+};
+
+/**
+ * \struct QuadTreeOptions
+ * \brief Parametrii unui StaticQuadTree.
+ */
+struct QuadTreeOptions
+{
+    float looseness = 2.f;  ///< Factorul cu care se mareste fiecare nod in jurul centrului sau (1 = quadtree strict, 2 = quadtree "loose" clasic).
+    int maxDepth = 12;      ///< Numarul maxim de niveluri ale arborelui, inclusiv radacina.
+    int splitThreshold = 16; ///< Numarul de elemente peste care o frunza se imparte (0 = impartire geometrica pana la maxDepth).
+    int mergeThreshold = 8; ///< Copiii unui nod se unesc inapoi in el cand au impreuna cel mult atatea elemente (0 = doar copiii goi).
+    QuadTreeUpdateMode updateMode = QuadTreeUpdateMode::Incremental; ///< Modul de actualizare intre cadre.
+};
 
 /**
  * \class StaticQuadTree
  * \brief O implementare statica a unei structuri de date quadtree.
  * \details StaticQuadTree este o clasa templata care reprezinta o structura de date quadtree. Este folosit pentru a partitiona un spatiu bidimensional in regiuni mai mici, permitand interogari spatiale eficiente.
+ *
+ * Nodurile sunt stocate intr-un singur vector (pool) si se refera unul la altul prin indici de 32 de biti.
+ * clear() nu elibereaza nodurile, doar marcheaza pool-ul ca gol: la reconstructia din cadrul urmator nodurile,
+ * impreuna cu vectorii lor de elemente, sunt refolosite fara alocari noi.
+ *
+ * In modul strict (looseness = 1) un element coboara intr-un copil doar daca incape in intregime in el, deci
+ * elementele care traverseaza granita dintre cadrane raman in parinte. In modul loose (looseness > 1) copilul este
+ * ales dupa centrul elementului, iar limitele copilului sunt marite de looseness ori in jurul centrului sau;
+ * elementul coboara daca incape in aceste limite marite, deci doar elementele mari raman sus in arbore.
+ *
+ * Cu splitThreshold = 0 arborele se imparte geometric: orice element coboara pana la maxDepth, indiferent cate
+ * elemente are un nod. Cu splitThreshold > 0 arborele este adaptiv: elementele raman intr-o frunza pana cand
+ * aceasta depaseste splitThreshold elemente, moment in care frunza se imparte si elementele ei coboara in copii.
+ * La remove(), un nod ai carui copii (frunze) au impreuna cel mult mergeThreshold elemente ii uneste inapoi,
+ * iar nodurile eliberate sunt refolosite de urmatoarele impartiri. In modul geometric, frunzele ramase goale dupa
+ * remove() sau update() sunt eliberate, impreuna cu parintii ramasi fara elemente si fara copii, astfel incat arborele
+ * nu creste la nesfarsit cand elementele se misca.
+ *
+ * Pentru fiecare element se retine nodul in care se afla, deci elementele trebuie sa fie indici densi (de exemplu
+ * ID-urile particulelor). Astfel update() si remove() gasesc nodul direct, fara sa coboare din radacina.
  */
 template <typename T>
 class StaticQuadTree
 {
 public:
+    static const uint32_t invalidNode = UINT32_MAX;                   ///< Indicele folosit pentru un copil inexistent.
+
+    /**
+     * \struct Node
+     * \brief Un nod din pool-ul quadtree-ului.
+     */
+    struct Node
+    {
+        Rectangle rectangle{};                                        ///< Dreptunghiul care reprezinta limitele nodului.
+        std::array<uint32_t, 4> children{ invalidNode, invalidNode, invalidNode, invalidNode }; ///< Indicii copiilor in pool.
+        uint32_t parent = invalidNode;                                ///< Indicele parintelui in pool (invalidNode pentru radacina).
+        uint32_t depth = 0;                                           ///< Adancimea nodului.
+        bool split = false;                                           ///< In modul adaptiv, nodul a fost impartit si elementele coboara in copii.
+        bool used = false;                                            ///< Nodul face parte din arbore (nodurile eliberate la unire sunt refolosite).
+        std::vector<std::pair<Rectangle, T>> items;                   ///< Elementele stocate la acest nivel.
+    };
+
     /**
      * \brief Construieste un obiect StaticQuadTree cu un dreptunghi initial optional si o adancime.
      * \param rectangle Dreptunghiul initial care reprezinta limitele quadtree-ului.
      * \param depth Adancimea initiala a quadtree-ului.
+     * \param options Parametrii quadtree-ului.
      */
-    StaticQuadTree(const Rectangle& rectangle = { 0.f, 0.f, 100.f, 100.f }, const size_t depth = 0) :
-        parent(this), rectangle(rectangle), depth(depth)
+    StaticQuadTree(const Rectangle& rectangle = { 0.f, 0.f, 100.f, 100.f }, const size_t depth = 0, const QuadTreeOptions& options = QuadTreeOptions()) :
+        rootDepth(static_cast<uint32_t>(depth)), options(options)
     {
         resize(rectangle);
     }
@@ -31,32 +92,53 @@ public:
      */
     void resize(const Rectangle& rArea)
     {
+        if (nodes.empty())
+            nodes.emplace_back();
+
         clear();
-        rectangle = rArea;
-        float childWidth = rectangle.width / 2.0f;
-        float childHeight = rectangle.height / 2.0f;
+        nodes[rootNode].rectangle = rArea;
+    }
 
-        childRec =
-        {
-            Rectangle {rectangle.x, rectangle.y, childWidth, childHeight},                                // top left
-            Rectangle {rectangle.x + childWidth, rectangle.y, childWidth, childHeight},                    // top right
-            Rectangle {rectangle.x, rectangle.y + childHeight, childWidth, childHeight},                // bottom left
-            Rectangle {rectangle.x + childWidth, rectangle.y + childHeight, childWidth, childHeight}    // bottom right
-        };
+    /**
+     * \brief Schimba parametrii quadtree-ului si il goleste.
+     * \param newOptions Noii parametri.
+     */
+    void setOptions(const QuadTreeOptions& newOptions)
+    {
+        options = newOptions;
+        clear();
+    }
+
+    /**
+     * \brief Returneaza parametrii quadtree-ului.
+     * \return Parametrii.
+     */
+    const QuadTreeOptions& getOptions() const
+    {
+        return options;
     }
 
     /**
      * \brief Curata quadtree-ul, eliminand toate elementele si nodurile copil.
+     *
+     * Nodurile raman in pool si sunt refolosite de urmatoarele inserari.
      */
     void clear()
     {
-        items.clear();
-        for (int i = 0; i < 4; i++)
+        for (uint32_t i = 0; i < nodeCount; i++)
         {
-            if (childPtr[i])
-                childPtr[i]->clear();
-            childPtr[i].reset();
+            nodes[i].items.clear();
+            nodes[i].used = false;
         }
+
+        Node& root = nodes[rootNode];
+        root.children.fill(invalidNode);
+        root.parent = invalidNode;
+        root.depth = rootDepth;
+        root.split = false;
+        root.used = true;
+        nodeCount = 1;
+        freeNodes.clear();
     }
 
     /**
@@ -65,10 +147,9 @@ public:
      */
     size_t size() const
     {
-        size_t count = items.size();
-        for (int i = 0; i < 4; i++)
-            if (childPtr[i])
-                count += childPtr[i]->size();
+        size_t count = 0;
+        for (uint32_t i = 0; i < nodeCount; i++)
+            count += nodes[i].items.size();
 
         return count;
     }
@@ -79,17 +160,15 @@ public:
      */
     size_t sizeOfDataStructure() const
     {
-        size_t count = items.size();
-        count += sizeof(depth);
-        count += sizeof(rectangle);
-        count += sizeof(parent);
-
-        for (int i = 0; i < 4; i++)
-            count += sizeof(childRec[i]);
+        size_t count = sizeof(nodeCount) + sizeof(rootDepth) + (freeNodes.size() + locations.size()) * sizeof(uint32_t);
+        for (uint32_t i = 0; i < nodeCount; i++)
+        {
+            if (!nodes[i].used)
+                continue;
 
-        for (int i = 0; i < 4; i++)
-            if (childPtr[i])
-                count += childPtr[i]->sizeOfDataStructure();
+            count += sizeof(Node);
+            count += nodes[i].items.size() * sizeof(std::pair<Rectangle, T>);
+        }
 
         return count;
     }
@@ -101,40 +180,89 @@ public:
      */
     void insert(const T& item, const Rectangle& itemSize)
     {
-        for (int i = 0; i < 4; i++)
+        place(descend(rootNode, itemSize), { itemSize, item });
+    }
+
+    /**
+     * \brief Actualizeaza dreptunghiul unui element deja inserat.
+     *
+     * Daca elementul inca incape in limitele nodului sau si nu poate cobori mai jos, doar dreptunghiul se
+     * actualizeaza pe loc. Altfel elementul urca prin parinti pana la primul nod in care incape si coboara
+     * de acolo, ca la inserare. In modul adaptiv nodul parasit poate fi unit cu fratii lui.
+     * \param item Elementul.
+     * \param itemSize Noul dreptunghi al elementului.
+     * \return `true` daca elementul exista in quadtree, `false` in caz contrar.
+     */
+    bool update(const T& item, const Rectangle& itemSize)
+    {
+        uint32_t nodeIdx = locate(item);
+        if (nodeIdx == invalidNode)
+            return false;
+
+        auto& items = nodes[nodeIdx].items;
+        size_t slot = findSlot(items, item);
+        if (fits(nodeIdx, itemSize) && (!canDescend(nodes[nodeIdx]) || childFor(nodes[nodeIdx].rectangle, itemSize) < 0))
         {
-            if (firstContainsSecond(childRec[i], itemSize))
-            {
-                // Am atins limita de adancime?
-                if (depth + 1 < maxDepth)
-                {
-                    // Exista copilul?
-                    if (!childPtr[i])
-                    {
-                        // Nu, creeaza unul
-                        childPtr[i] = std::make_shared<StaticQuadTree<T>>(childRec[i], depth + 1);
-                        childPtr[i]->parent = this;
-                    }
-
-                    childPtr[i]->insert(item, itemSize);
-                    return;
-                }
-            }
+            items[slot].first = itemSize;
+            return true;
         }
 
-        items.push_back({ itemSize, item });
+        items[slot] = items.back();
+        items.pop_back();
+
+        uint32_t targetIdx = nodeIdx;
+        while (!fits(targetIdx, itemSize))
+            targetIdx = nodes[targetIdx].parent;
+
+        place(descend(targetIdx, itemSize), { itemSize, item });
+        releaseNodes(nodeIdx);
+        return true;
     }
 
     /**
-     * \brief Cauta elemente intr-o zona specificata.
+     * \brief Elimina un element din quadtree.
+     *
+     * In modul adaptiv, nodurile ai caror copii au ramas cu cel mult mergeThreshold elemente sunt unite, de jos in sus.
+     * \param item Elementul de eliminat.
+     * \return `true` daca elementul a fost gasit si eliminat, `false` in caz contrar.
+     */
+    bool remove(const T& item)
+    {
+        uint32_t nodeIdx = locate(item);
+        if (nodeIdx == invalidNode)
+            return false;
+
+        auto& items = nodes[nodeIdx].items;
+        size_t slot = findSlot(items, item);
+        items[slot] = items.back();
+        items.pop_back();
+        locations[static_cast<size_t>(item)] = invalidNode;
+
+        releaseNodes(nodeIdx);
+        return true;
+    }
+
+    /**
+     * \brief Cauta elemente intr-o zona specificata si le adauga la sfarsitul vectorului dat.
+     *
+     * Vectorul nu este golit, iar daca este refolosit intre apeluri cautarea nu aloca memorie.
+     * \param rArea Zona in care se cauta elemente.
+     * \param listItems Vectorul in care se adauga elementele gasite.
+     */
+    void search(const Rectangle& rArea, std::vector<T>& listItems) const
+    {
+        forEachInArea(rArea, [&listItems](const T& item) { listItems.push_back(item); });
+    }
+
+    /**
+     * \brief Apeleaza visit pentru fiecare element care se intersecteaza cu zona specificata, fara alocari.
      * \param rArea Zona in care se cauta elemente.
-     * \return O lista de elemente in interiorul zonei specificate.
+     * \param visit Functia apelata cu fiecare element gasit.
      */
-    std::list<T> _search(const Rectangle& rArea) const
+    template <typename Visitor>
+    void forEachInArea(const Rectangle& rArea, Visitor&& visit) const
     {
-        std::list<T> listItems;
-        search(rArea, listItems);
-        return listItems;
+        search(rootNode, rArea, visit);
     }
 
     /**
@@ -161,22 +289,35 @@ public:
      */
     void traverse()
     {
-        DrawRectangleLines(rectangle.x, rectangle.y, rectangle.width, rectangle.height, GRAY);
-
-        for (int i = 0; i < 4; i++)
+        forEachNodeRectangle([](const Rectangle& rectangle)
         {
-            if (childPtr[i])
-                childPtr[i]->traverse();
-        }
+            DrawRectangleLines(rectangle.x, rectangle.y, rectangle.width, rectangle.height, GRAY);
+        });
     }
 
     /**
-     * \brief Returneaza dreptunghiul quadtree-ului parinte.
-     * \return Dreptunghiul quadtree-ului parinte.
+     * \brief Apeleaza visit cu dreptunghiul fiecarui nod folosit.
+     * \param visit Functia apelata cu dreptunghiul fiecarui nod.
      */
-    Rectangle getParentRec()
+    template <typename Visitor>
+    void forEachNodeRectangle(Visitor&& visit) const
     {
-        return parent->rectangle;
+        for (uint32_t i = 0; i < nodeCount; i++)
+            if (nodes[i].used)
+                visit(nodes[i].rectangle);
+    }
+
+    /**
+     * \brief Apeleaza visit cu dreptunghiul fiecarui nod folosit din primele levels niveluri ale arborelui.
+     * \param levels Numarul de niveluri vizitate (1 = doar radacina).
+     * \param visit Functia apelata cu dreptunghiul fiecarui nod.
+     */
+    template <typename Visitor>
+    void forEachNodeRectangle(size_t levels, Visitor&& visit) const
+    {
+        for (uint32_t i = 0; i < nodeCount; i++)
+            if (nodes[i].used && nodes[i].depth - rootDepth < levels)
+                visit(nodes[i].rectangle);
     }
 
     /**
@@ -185,86 +326,449 @@ public:
      */
     Rectangle getRec()
     {
-        return rectangle;
+        return nodes[rootNode].rectangle;
     }
 
     /**
-     * \brief Returneaza quadtree-ul parinte.
-     * \return Un pointer la quadtree-ul parinte.
+     * \brief Returneaza numarul de noduri din arbore.
+     * \return Numarul de noduri folosite, fara cele eliberate la unire.
      */
-    StaticQuadTree<T>* getParent()
+    size_t getNodeCount() const
     {
-        return parent;
+        return nodeCount - freeNodes.size();
     }
 
     /**
-     * \brief Returneaza quadtree-ul copil de la indexul specificat.
-     * \param i Indexul quadtree-ului copil.
-     * \return Un pointer partajat la quadtree-ul copil.
+     * \brief Returneaza adancimea maxima atinsa de arbore.
+     * \return Cel mai mare numar de niveluri de la radacina la o frunza.
      */
-    std::shared_ptr<StaticQuadTree<T>> getChildPtr(int i)
+    size_t getDepth() const
     {
-        return childPtr[i];
+        uint32_t depth = rootDepth;
+        for (uint32_t i = 0; i < nodeCount; i++)
+            if (nodes[i].used && nodes[i].depth > depth)
+                depth = nodes[i].depth;
+
+        return depth - rootDepth + 1;
     }
 
     /**
-     * \brief Returneaza un vector de elemente stocate in quadtree.
-     * \return Un vector de elemente stocate in quadtree.
+     * \brief Returneaza un nod din pool.
+     * \param nodeIdx Indicele nodului (mai mic decat nodeCount; nodurile eliberate au used = false).
+     * \return Nodul.
      */
-    std::vector<std::pair<Rectangle, T>> getItems()
+    const Node& getNode(uint32_t nodeIdx) const
     {
-        return items;
+        return nodes[nodeIdx];
     }
 
 protected:
     /**
-     * \brief Recupereaza elementele din zona specificata si le adauga in lista furnizata.
+     * \brief Calculeaza dreptunghiul unui copil.
+     * \param rectangle Dreptunghiul parintelui.
+     * \param i Indexul copilului: 0 stanga sus, 1 dreapta sus, 2 stanga jos, 3 dreapta jos.
+     * \return Dreptunghiul copilului.
+     */
+    static Rectangle childRectangle(const Rectangle& rectangle, int i)
+    {
+        float childWidth = rectangle.width / 2.0f;
+        float childHeight = rectangle.height / 2.0f;
+
+        return Rectangle{ rectangle.x + (i & 1) * childWidth, rectangle.y + (i >> 1) * childHeight, childWidth, childHeight };
+    }
+
+    /**
+     * \brief Calculeaza limitele in care trebuie sa incapa elementele unui nod (marite de looseness ori in jurul centrului).
+     * \param rectangle Dreptunghiul nodului.
+     * \return Limitele nodului.
+     */
+    Rectangle looseBounds(const Rectangle& rectangle) const
+    {
+        if (options.looseness <= 1.f)
+            return rectangle;
+
+        float marginX = rectangle.width * (options.looseness - 1.f) / 2.f;
+        float marginY = rectangle.height * (options.looseness - 1.f) / 2.f;
+        return Rectangle{ rectangle.x - marginX, rectangle.y - marginY, rectangle.width + 2.f * marginX, rectangle.height + 2.f * marginY };
+    }
+
+    /**
+     * \brief Alege copilul in care coboara un element.
+     * \param rectangle Dreptunghiul nodului curent.
+     * \param itemSize Dreptunghiul elementului.
+     * \return Indexul copilului, sau -1 daca elementul ramane in nodul curent.
+     */
+    int childFor(const Rectangle& rectangle, const Rectangle& itemSize) const
+    {
+        if (options.looseness <= 1.f)
+        {
+            for (int i = 0; i < 4; i++)
+                if (firstContainsSecond(childRectangle(rectangle, i), itemSize))
+                    return i;
+            return -1;
+        }
+
+        // cadranul centrului elementului
+        float centerX = itemSize.x + itemSize.width / 2.f;
+        float centerY = itemSize.y + itemSize.height / 2.f;
+        int i = (centerX >= rectangle.x + rectangle.width / 2.f ? 1 : 0) + (centerY >= rectangle.y + rectangle.height / 2.f ? 2 : 0);
+
+        return firstContainsSecond(looseBounds(childRectangle(rectangle, i)), itemSize) ? i : -1;
+    }
+
+    /**
+     * \brief Verifica daca elementele unui nod pot cobori in copii.
+     * \param node Nodul.
+     * \return `true` daca nodul nu a atins maxDepth si, in modul adaptiv, a fost impartit.
+     */
+    bool canDescend(const Node& node) const
+    {
+        if (node.depth - rootDepth + 1 >= static_cast<uint32_t>(options.maxDepth))
+            return false;
+
+        return options.splitThreshold <= 0 || node.split;
+    }
+
+    /**
+     * \brief Coboara de la un nod pana la nodul in care trebuie inserat un element, creand copiii lipsa de pe drum.
+     * \param startIdx Indicele nodului de pornire (elementul trebuie sa incapa in el).
+     * \param itemSize Dreptunghiul elementului.
+     * \return Indicele nodului.
+     */
+    uint32_t descend(uint32_t startIdx, const Rectangle& itemSize)
+    {
+        uint32_t nodeIdx = startIdx;
+
+        while (canDescend(nodes[nodeIdx]))
+        {
+            int i = childFor(nodes[nodeIdx].rectangle, itemSize);
+            if (i < 0)
+                break;
+
+            // Exista copilul? Daca nu, il ia din pool
+            if (nodes[nodeIdx].children[i] == invalidNode)
+            {
+                // allocateNode poate realoca pool-ul, deci indicele se scrie dupa apel
+                uint32_t childIdx = allocateNode(nodeIdx, childRectangle(nodes[nodeIdx].rectangle, i));
+                nodes[nodeIdx].children[i] = childIdx;
+            }
+
+            nodeIdx = nodes[nodeIdx].children[i];
+        }
+
+        return nodeIdx;
+    }
+
+    /**
+     * \brief Verifica daca un element poate ramane intr-un nod.
+     * \param nodeIdx Indicele nodului.
+     * \param itemSize Dreptunghiul elementului.
+     * \return `true` pentru radacina sau daca elementul incape in limitele (marite) ale nodului si, in modul loose,
+     * centrul lui este in nod (altfel insert() l-ar fi pus in alt nod, iar elementele s-ar aduna in nodurile impartite).
+     */
+    bool fits(uint32_t nodeIdx, const Rectangle& itemSize) const
+    {
+        if (nodeIdx == rootNode)
+            return true;
+
+        const Rectangle& rectangle = nodes[nodeIdx].rectangle;
+        if (options.looseness > 1.f)
+        {
+            float centerX = itemSize.x + itemSize.width / 2.f;
+            float centerY = itemSize.y + itemSize.height / 2.f;
+            if (centerX < rectangle.x || centerX >= rectangle.x + rectangle.width ||
+                centerY < rectangle.y || centerY >= rectangle.y + rectangle.height)
+                return false;
+        }
+
+        return firstContainsSecond(looseBounds(rectangle), itemSize);
+    }
+
+    /**
+     * \brief Adauga un element intr-un nod, retine nodul elementului si imparte nodul daca a depasit splitThreshold.
+     * \param nodeIdx Indicele nodului.
+     * \param entry Dreptunghiul si elementul.
+     */
+    void place(uint32_t nodeIdx, const std::pair<Rectangle, T>& entry)
+    {
+        nodes[nodeIdx].items.push_back(entry);
+        setLocation(entry.second, nodeIdx);
+
+        if (options.splitThreshold > 0 && nodes[nodeIdx].items.size() > static_cast<size_t>(options.splitThreshold))
+            splitNode(nodeIdx);
+    }
+
+    /**
+     * \brief Retine nodul in care se afla un element.
+     * \param item Elementul.
+     * \param nodeIdx Indicele nodului.
+     */
+    void setLocation(const T& item, uint32_t nodeIdx)
+    {
+        size_t index = static_cast<size_t>(item);
+        if (index >= locations.size())
+            locations.resize(index + 1, invalidNode);
+
+        locations[index] = nodeIdx;
+    }
+
+    /**
+     * \brief Returneaza nodul in care se afla un element.
+     * \param item Elementul.
+     * \return Indicele nodului, sau invalidNode daca elementul nu este in quadtree.
+     */
+    uint32_t locate(const T& item) const
+    {
+        size_t index = static_cast<size_t>(item);
+        if (index >= locations.size())
+            return invalidNode;
+
+        // dupa clear() intrarile vechi raman in vector, deci se verifica si nodul
+        uint32_t nodeIdx = locations[index];
+        if (nodeIdx == invalidNode || nodeIdx >= nodeCount || !nodes[nodeIdx].used || findSlot(nodes[nodeIdx].items, item) == nodes[nodeIdx].items.size())
+            return invalidNode;
+
+        return nodeIdx;
+    }
+
+    /**
+     * \brief Cauta un element in lista unui nod.
+     * \param items Elementele nodului.
+     * \param item Elementul cautat.
+     * \return Pozitia elementului, sau items.size() daca nu exista.
+     */
+    static size_t findSlot(const std::vector<std::pair<Rectangle, T>>& items, const T& item)
+    {
+        size_t slot = 0;
+        while (slot < items.size() && !(items[slot].second == item))
+            slot++;
+
+        return slot;
+    }
+
+    /**
+     * \brief Imparte o frunza in modul adaptiv: creeaza cei patru copii si muta in ei elementele care incap.
+     *
+     * Copiii care depasesc la randul lor splitThreshold sunt impartiti recursiv, pana la maxDepth.
+     * \param nodeIdx Indicele frunzei.
+     */
+    void splitNode(uint32_t nodeIdx)
+    {
+        if (nodes[nodeIdx].split || nodes[nodeIdx].depth - rootDepth + 1 >= static_cast<uint32_t>(options.maxDepth))
+            return;
+
+        // allocateNode poate realoca pool-ul, deci referintele la noduri se iau dupa alocari
+        for (int i = 0; i < 4; i++)
+        {
+            if (nodes[nodeIdx].children[i] == invalidNode)
+            {
+                uint32_t childIdx = allocateNode(nodeIdx, childRectangle(nodes[nodeIdx].rectangle, i));
+                nodes[nodeIdx].children[i] = childIdx;
+            }
+        }
+
+        Node& node = nodes[nodeIdx];
+        node.split = true;
+
+        size_t kept = 0;
+        for (size_t k = 0; k < node.items.size(); k++)
+        {
+            int i = childFor(node.rectangle, node.items[k].first);
+            if (i < 0)
+                node.items[kept++] = node.items[k];
+            else
+            {
+                nodes[node.children[i]].items.push_back(node.items[k]);
+                setLocation(node.items[k].second, node.children[i]);
+            }
+        }
+        node.items.resize(kept);
+
+        std::array<uint32_t, 4> children = node.children;
+        for (uint32_t childIdx : children)
+            if (nodes[childIdx].items.size() > static_cast<size_t>(options.splitThreshold))
+                splitNode(childIdx);
+    }
+
+    /**
+     * \brief Elibereaza nodurile care nu mai sunt necesare dupa ce un element a parasit un nod.
+     * \param nodeIdx Indicele nodului parasit.
+     */
+    void releaseNodes(uint32_t nodeIdx)
+    {
+        if (options.splitThreshold <= 0)
+            releaseEmptyLeaves(nodeIdx);
+        else
+            mergeUpwards(nodes[nodeIdx].split ? nodeIdx : nodes[nodeIdx].parent);
+    }
+
+    /**
+     * \brief Elibereaza, de jos in sus, frunzele fara elemente (modul geometric, in care copiii se creeaza pe rand).
+     * \param nodeIdx Indicele primului nod verificat.
+     */
+    void releaseEmptyLeaves(uint32_t nodeIdx)
+    {
+        while (nodeIdx != rootNode && nodes[nodeIdx].items.empty())
+        {
+            Node& node = nodes[nodeIdx];
+            for (uint32_t childIdx : node.children)
+                if (childIdx != invalidNode)
+                    return;
+
+            uint32_t parentIdx = node.parent;
+            for (uint32_t& childIdx : nodes[parentIdx].children)
+                if (childIdx == nodeIdx)
+                    childIdx = invalidNode;
+
+            node.used = false;
+            freeNodes.push_back(nodeIdx);
+            nodeIdx = parentIdx;
+        }
+    }
+
+    /**
+     * \brief Uneste, de jos in sus, nodurile ai caror copii sunt frunze cu cel mult mergeThreshold elemente in total.
+     *
+     * Cu mergeThreshold = 0 sunt unite doar grupurile de copii ramase fara elemente.
+     * \param nodeIdx Indicele primului nod verificat.
+     */
+    void mergeUpwards(uint32_t nodeIdx)
+    {
+        if (options.splitThreshold <= 0)
+            return;
+
+        while (nodeIdx != invalidNode && nodes[nodeIdx].split)
+        {
+            Node& node = nodes[nodeIdx];
+
+            size_t count = 0;
+            for (uint32_t childIdx : node.children)
+            {
+                if (childIdx == invalidNode)
+                    continue;
+                if (nodes[childIdx].split)
+                    return;
+                count += nodes[childIdx].items.size();
+            }
+
+            if (count > static_cast<size_t>(std::max(options.mergeThreshold, 0)))
+                return;
+
+            for (uint32_t& childIdx : node.children)
+            {
+                if (childIdx == invalidNode)
+                    continue;
+
+                Node& child = nodes[childIdx];
+                for (const auto& entry : child.items)
+                    setLocation(entry.second, nodeIdx);
+                node.items.insert(node.items.end(), child.items.begin(), child.items.end());
+                child.items.clear();
+                child.used = false;
+                freeNodes.push_back(childIdx);
+                childIdx = invalidNode;
+            }
+            node.split = false;
+
+            nodeIdx = node.parent;
+        }
+    }
+
+    /**
+     * \brief Ia un nod liber din pool: intai unul eliberat la unire, apoi urmatorul nefolosit; pool-ul creste doar daca
+     * arborele depaseste cel mai mare arbore de pana acum.
+     * \param parentIdx Indicele parintelui.
+     * \param rectangle Dreptunghiul noului nod.
+     * \return Indicele noului nod.
+     */
+    uint32_t allocateNode(uint32_t parentIdx, const Rectangle& rectangle)
+    {
+        uint32_t nodeIdx;
+        if (!freeNodes.empty())
+        {
+            nodeIdx = freeNodes.back();
+            freeNodes.pop_back();
+        }
+        else
+        {
+            if (nodeCount == nodes.size())
+                nodes.emplace_back();
+            nodeIdx = nodeCount++;
+        }
+
+        Node& node = nodes[nodeIdx];
+        node.rectangle = rectangle;
+        node.children.fill(invalidNode);
+        node.parent = parentIdx;
+        node.depth = nodes[parentIdx].depth + 1;
+        node.split = false;
+        node.used = true;
+        node.items.clear();
+
+        return nodeIdx;
+    }
+
+    /**
+     * \brief Recupereaza elementele din zona specificata si le transmite functiei visit.
+     * \param nodeIdx Indicele nodului de la care incepe cautarea.
      * \param rArea Zona in care se cauta elemente.
-     * \param listItems Lista in care se vor stoca elementele gasite.
+     * \param visit Functia apelata cu fiecare element gasit.
      */
-    void search(const Rectangle& rArea, std::list<T>& listItems) const
+    template <typename Visitor>
+    void search(uint32_t nodeIdx, const Rectangle& rArea, Visitor& visit) const
     {
-        for (const auto& p : items)
+        const Node& node = nodes[nodeIdx];
+        for (const auto& p : node.items)
         {
             if (CheckCollisionRecs(rArea, p.first))
-                listItems.push_back(p.second);
+                visit(p.second);
         }
 
         for (int i = 0; i < 4; i++)
         {
-            if (childPtr[i])
+            if (node.children[i] != invalidNode)
             {
-                if (firstContainsSecond(rArea, childRec[i]))
+                Rectangle childRec = looseBounds(childRectangle(node.rectangle, i));
+                if (firstContainsSecond(rArea, childRec))
                 {
-                    childPtr[i]->retriveItems(listItems);
+                    retriveItems(node.children[i], visit);
                 }
-                else if (CheckCollisionRecs(childRec[i], rArea))
+                else if (CheckCollisionRecs(childRec, rArea))
                 {
-                    childPtr[i]->search(rArea, listItems);
+                    search(node.children[i], rArea, visit);
                 }
             }
         }
     }
 
     /**
-     * \brief Recupereaza elementele stocate in quadtree si le adauga in lista furnizata.
-     * \param listItems Lista in care se vor stoca elementele recuperate.
+     * \brief Recupereaza elementele stocate in quadtree si le transmite functiei visit.
+     * \param nodeIdx Indicele nodului de la care incepe recuperarea.
+     * \param visit Functia apelata cu fiecare element recuperat.
      */
-    void retriveItems(std::list<T>& listItems) const
+    template <typename Visitor>
+    void retriveItems(uint32_t nodeIdx, Visitor& visit) const
     {
-        for (const auto& p : items)
-            listItems.push_back(p.second);
+        const Node& node = nodes[nodeIdx];
+        for (const auto& p : node.items)
+            visit(p.second);
 
         for (int i = 0; i < 4; i++)
-            if (childPtr[i])
-                childPtr[i]->retriveItems(listItems);
+            if (node.children[i] != invalidNode)
+                retriveItems(node.children[i], visit);
     }
 
-    StaticQuadTree<T>* parent = nullptr;                             ///< Pointer la quadtree-ul parinte.
-    size_t depth = 0;                                                ///< Adancimea quadtree-ului.
-    Rectangle rectangle;                                             ///< Dreptunghiul care reprezinta limitele quadtree-ului.
-    std::array<Rectangle, 4> childRec{};                              ///< Dreptunghiurile copiilor quadtree-ului.
-    std::array<std::shared_ptr<StaticQuadTree<T>>, 4> childPtr{};     ///< Pointeri la quadtree-urile copii.
-    std::vector<std::pair<Rectangle, T>> items;                       ///< Container pentru elementele stocate la acest nivel.
-    static const int maxDepth = 7;                                    ///< Adancimea maxima a quadtree-ului.
+    static const uint32_t rootNode = 0;                               ///< Indicele radacinii in pool.
+    std::vector<Node> nodes;                                          ///< Pool-ul de noduri, refolosit intre cadre.
+    std::vector<uint32_t> freeNodes;                                  ///< Nodurile eliberate la unire, refolosite inaintea celor nefolosite.
+    std::vector<uint32_t> locations;                                  ///< Nodul fiecarui element, indexat dupa element.
+    uint32_t nodeCount = 0;                                           ///< Numarul de noduri folosite din pool.
+    uint32_t rootDepth = 0;                                           ///< Adancimea radacinii.
+    QuadTreeOptions options;                                          ///< Parametrii quadtree-ului.
 };
+
+template <typename T>
+const uint32_t StaticQuadTree<T>::invalidNode;
+
+template <typename T>
+const uint32_t StaticQuadTree<T>::rootNode;
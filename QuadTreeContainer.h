@@ -1,35 +1,48 @@
 #pragma once
 #include <iostream>
+#include <vector>
+#include <algorithm>
 #include "QuadTree.h"
 
 /**
- * \brief Un container care utilizeaza un quadtree static pentru a stoca elemente de tip T.
+ * \brief Un container care utilizeaza un quadtree static pentru a stoca ID-urile particulelor din T.
  *
  * Clasa template StaticQuadTreeContainer este un container care utilizeaza o structura de date quadtree
- * static pentru a stoca si gestiona elemente de tip T. Aceasta permite insertia, eliminarea si cautarea
- * eficienta a elementelor pe baza pozitiei lor intr-un spatiu 2D.
+ * static pentru a stoca si gestiona ID-urile dense ale particulelor dintr-o stocare de tip T (de exemplu ParticleStore).
+ * Aceasta permite insertia, eliminarea si cautarea eficienta a elementelor pe baza pozitiei lor intr-un spatiu 2D.
  */
 template <typename T>
 class StaticQuadTreeContainer
 {
-    using QuadTreeContainer = std::list<std::shared_ptr<T>>;  ///< Tipul de container subiacent.
+    using QuadTreeContainer = std::vector<int>;  ///< Tipul de container subiacent.
 
 protected:
-    QuadTreeContainer allItems; ///< Lista tuturor elementelor din container.
-    StaticQuadTree<typename QuadTreeContainer::iterator> root; ///< Radacina quadtree-ului static.
-    std::list<std::shared_ptr<StaticQuadTree<typename QuadTreeContainer::iterator>>> leaves; ///< Nodurile quadtree-ului.
+    QuadTreeContainer allItems; ///< Lista ID-urilor tuturor elementelor din container.
+    StaticQuadTree<int> root; ///< Radacina quadtree-ului static.
 
 public:
     /**
      * \brief Construieste un obiect StaticQuadTreeContainer cu dreptunghiul si adancimea specificate.
      * \param rectangle Dreptunghiul de delimitare al quadtree-ului.
      * \param depth Adancimea maxima a quadtree-ului.
+     * \param options Parametrii quadtree-ului.
      */
-    StaticQuadTreeContainer(const Rectangle& rectangle, const size_t depth) : root(rectangle, depth)
+    StaticQuadTreeContainer(const Rectangle& rectangle, const size_t depth, const QuadTreeOptions& options = QuadTreeOptions()) :
+        root(rectangle, depth, options)
     {
 
     }
 
+    /**
+     * \brief Schimba parametrii quadtree-ului. Goleste containerul.
+     * \param options Noii parametri.
+     */
+    void setOptions(const QuadTreeOptions& options)
+    {
+        root.setOptions(options);
+        allItems.clear();
+    }
+
     /**
      * \brief Redimensioneaza quadtree-ul pentru a se potrivi cu zona specificata.
      * \param rArea Noul dreptunghi de delimitare al quadtree-ului.
@@ -57,6 +70,15 @@ public:
         return root.sizeOfDataStructure();
     }
 
+    /**
+     * \brief Returneaza quadtree-ul folosit de container.
+     * \return Quadtree-ul.
+     */
+    const StaticQuadTree<int>& getTree() const
+    {
+        return root;
+    }
+
     /**
      * \brief Verifica daca containerul este gol.
      * \return `true` daca containerul este gol, `false` in caz contrar.
@@ -77,30 +99,57 @@ public:
 
     /**
      * \brief Insereaza un element in container la pozitia specificata.
-     * \param item Un pointer partajat la elementul de inserat.
+     * \param id ID-ul elementului de inserat.
      * \param itemSize Dimensiunea dreptunghiulara a elementului.
      */
-    void insert(const std::shared_ptr<T> item, const Rectangle& itemSize)
+    void insert(int id, const Rectangle& itemSize)
     {
-        allItems.push_back(item);
-        root.insert(std::prev(allItems.end()), itemSize);
+        allItems.push_back(id);
+        root.insert(id, itemSize);
+    }
+
+    /**
+     * \brief Elimina un element din container.
+     * \param id ID-ul elementului de eliminat.
+     * \return `true` daca elementul a fost gasit si eliminat, `false` in caz contrar.
+     */
+    bool remove(int id)
+    {
+        auto it = std::find(allItems.begin(), allItems.end(), id);
+        if (it == allItems.end() || !root.remove(id))
+            return false;
+
+        *it = allItems.back();
+        allItems.pop_back();
+        return true;
     }
 
     /**
      * \brief Cauta elemente in interiorul zonei specificate.
      * \param rArea Zona in care se cauta.
-     * \return O lista de iteratori care indica elementele gasite in zona respectiva.
+     * \param result Vectorul la care se adauga ID-urile gasite (nu este golit; refolosit, nu aloca memorie).
+     */
+    void search(const Rectangle& rArea, std::vector<int>& result) const
+    {
+        root.search(rArea, result);
+    }
+
+    /**
+     * \brief Apeleaza visit cu ID-ul fiecarui element din interiorul zonei specificate, fara alocari.
+     * \param rArea Zona in care se cauta.
+     * \param visit Functia apelata cu fiecare ID gasit.
      */
-    std::list<typename QuadTreeContainer::iterator> search(const Rectangle& rArea) const
+    template <typename Visitor>
+    void forEachInArea(const Rectangle& rArea, Visitor&& visit) const
     {
-        return root._search(rArea);
+        root.forEachInArea(rArea, visit);
     }
 
     /**
      * \brief Returneaza un iterator care indica inceputul containerului.
      * \return Un iterator care indica inceputul containerului.
      */
-    typename QuadTreeContainer::iterator begin()
+    typename QuadTreeContainer::const_iterator begin() const
     {
         return allItems.begin();
     }
@@ -109,25 +158,48 @@ public:
      * \brief Returneaza un iterator care indica sfarsitul containerului.
      * \return Un iterator care indica sfarsitul containerului.
      */
-    typename QuadTreeContainer::iterator end()
+    typename QuadTreeContainer::const_iterator end() const
     {
         return allItems.end();
     }
 
     /**
-     * \brief Actualizeaza quadtree-ul prin reinserarea tuturor elementelor.
+     * \brief Actualizeaza quadtree-ul dupa ce pozitiile sau dimensiunile elementelor s-au modificat.
      *
-     * Aceasta functie actualizeaza quadtree-ul prin reinserarea tuturor elementelor in el. Este apelata
-     * atunci cand pozitiile sau dimensiunile elementelor s-au modificat.
+     * In modul QuadTreeUpdateMode::Incremental se muta doar elementele care au iesit din limitele nodului lor;
+     * cu un pas de timp mic majoritatea particulelor raman in acelasi nod de la un cadru la altul.
+     * In modul QuadTreeUpdateMode::Rebuild se apeleaza rebuild().
+     *
+     * \param particles Stocarea din care se citesc pozitiile si razele elementelor.
+     */
+    void update(const T& particles)
+    {
+        if (root.getOptions().updateMode == QuadTreeUpdateMode::Rebuild)
+        {
+            rebuild(particles);
+            return;
+        }
+
+        for (int id : allItems)
+        {
+            float radius = particles.radius[id];
+            root.update(id, Rectangle{ particles.x[id] - radius, particles.y[id] - radius, radius * 2.f, radius * 2.f });
+        }
+    }
+
+    /**
+     * \brief Actualizeaza quadtree-ul prin golirea lui si reinserarea tuturor elementelor.
+     *
+     * \param particles Stocarea din care se citesc pozitiile si razele elementelor.
      */
-    void update()
+    void rebuild(const T& particles)
     {
         root.clear();
 
-        for (auto iter = allItems.begin(); iter != allItems.end(); ++iter)
+        for (int id : allItems)
         {
-            auto it = *iter;
-            root.insert(iter, Rectangle{ it->getX() - it->getRadius(), it->getY() - it->getRadius(), it->getRadius() * 2.f, it->getRadius() * 2.f });
+            float radius = particles.radius[id];
+            root.insert(id, Rectangle{ particles.x[id] - radius, particles.y[id] - radius, radius * 2.f, radius * 2.f });
         }
     }
 
@@ -142,6 +214,27 @@ public:
         root.traverse();
     }
 
+    /**
+     * \brief Apeleaza visit cu dreptunghiul fiecarui nod din quadtree.
+     * \param visit Functia apelata cu dreptunghiul fiecarui nod.
+     */
+    template <typename Visitor>
+    void forEachNodeRectangle(Visitor&& visit) const
+    {
+        root.forEachNodeRectangle(visit);
+    }
+
+    /**
+     * \brief Apeleaza visit cu dreptunghiul fiecarui nod din primele levels niveluri ale quadtree-ului.
+     * \param levels Numarul de niveluri vizitate (1 = doar radacina).
+     * \param visit Functia apelata cu dreptunghiul fiecarui nod.
+     */
+    template <typename Visitor>
+    void forEachNodeRectangle(size_t levels, Visitor&& visit) const
+    {
+        root.forEachNodeRectangle(levels, visit);
+    }
+
     /**
      * \brief Verifica daca primul dreptunghi contine al doilea dreptunghi.
      * \param first Primul dreptunghi.
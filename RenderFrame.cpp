@@ -0,0 +1,51 @@
+#include "RenderFrame.h"
+
+void RenderFrame::clear()
+{
+	x.clear();
+	y.clear();
+	radius.clear();
+	lines.clear();
+}
+
+void RenderFrame::reserveLines(size_t lineCount)
+{
+	lines.reserve(lines.size() + 2 * lineCount);
+}
+
+void RenderFrame::addLine(Vector2 start, Vector2 end)
+{
+	lines.push_back(start);
+	lines.push_back(end);
+}
+
+void RenderFrame::addRectangleLines(Rectangle rectangle)
+{
+	Vector2 topLeft{ rectangle.x, rectangle.y };
+	Vector2 topRight{ rectangle.x + rectangle.width, rectangle.y };
+	Vector2 bottomLeft{ rectangle.x, rectangle.y + rectangle.height };
+	Vector2 bottomRight{ rectangle.x + rectangle.width, rectangle.y + rectangle.height };
+
+	addLine(topLeft, topRight);
+	addLine(topLeft, bottomLeft);
+	addLine(topRight, bottomRight);
+	addLine(bottomLeft, bottomRight);
+}
+
+void RenderFrame::draw() const
+{
+	drawCircles();
+	drawLines();
+}
+
+void RenderFrame::drawCircles() const
+{
+	for (size_t id = 0; id < x.size(); id++)
+		DrawCircle(x[id], y[id], radius[id], BLACK);
+}
+
+void RenderFrame::drawLines() const
+{
+	for (size_t i = 0; i + 1 < lines.size(); i += 2)
+		DrawLine(lines[i].x, lines[i].y, lines[i + 1].x, lines[i + 1].y, GRAY);
+}
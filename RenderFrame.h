@@ -0,0 +1,57 @@
+#pragma once
+#include <vector>
+#include "raylib.h"
+
+/**
+ * \struct RenderFrame
+ * \brief Tot ce este necesar pentru desenarea unui cadru, copiat din ParticleManager dupa actualizare.
+ *
+ * Desenarea citeste doar acest instantaneu, nu si particulele sau containerele, astfel incat simularea cadrului
+ * urmator poate rula pe alt fir in timp ce cadrul curent este desenat (vezi SimulationPipeline).
+ */
+struct RenderFrame
+{
+    std::vector<float> x;        ///< Coordonatele X ale particulelor.
+    std::vector<float> y;        ///< Coordonatele Y ale particulelor.
+    std::vector<float> radius;   ///< Razele particulelor.
+    std::vector<Vector2> lines;  ///< Liniile structurii algoritmului curent, cate doua puncte (inceput, sfarsit) pe linie.
+
+    /**
+     * \brief Goleste instantaneul, pastrand memoria alocata.
+     */
+    void clear();
+
+    /**
+     * \brief Rezerva memorie pentru liniile care urmeaza sa fie adaugate, ca bufferul sa nu fie realocat pe parcurs.
+     * \param lineCount Numarul de linii care vor fi adaugate.
+     */
+    void reserveLines(size_t lineCount);
+
+    /**
+     * \brief Adauga o linie.
+     * \param start Inceputul liniei.
+     * \param end Sfarsitul liniei.
+     */
+    void addLine(Vector2 start, Vector2 end);
+
+    /**
+     * \brief Adauga cele patru laturi ale unui dreptunghi.
+     * \param rectangle Dreptunghiul.
+     */
+    void addRectangleLines(Rectangle rectangle);
+
+    /**
+     * \brief Deseneaza particulele si liniile.
+     */
+    void draw() const;
+
+    /**
+     * \brief Deseneaza particulele, cate un DrawCircle pentru fiecare.
+     */
+    void drawCircles() const;
+
+    /**
+     * \brief Deseneaza liniile structurii algoritmului.
+     */
+    void drawLines() const;
+};
@@ -0,0 +1,89 @@
+#include "SimulationPipeline.h"
+#include <algorithm>
+#include <chrono>
+
+SimulationPipeline::SimulationPipeline(ParticleManager& pm) : pm(pm)
+{
+
+}
+
+SimulationPipeline::~SimulationPipeline()
+{
+	stop();
+}
+
+void SimulationPipeline::start()
+{
+	if (running)
+		return;
+
+	pm.captureFrame(frames[0]);
+	front = 0;
+	back = 1;
+	ready = 2;
+
+	running = true;
+	thread = std::thread(&SimulationPipeline::run, this);
+}
+
+void SimulationPipeline::stop()
+{
+	running = false;
+	if (thread.joinable())
+		thread.join();
+}
+
+bool SimulationPipeline::isRunning() const
+{
+	return running;
+}
+
+void SimulationPipeline::setPaused(bool paused)
+{
+	this->paused = paused;
+}
+
+std::unique_lock<std::mutex> SimulationPipeline::holdSimulation()
+{
+	return std::unique_lock<std::mutex>(stateMutex);
+}
+
+const RenderFrame& SimulationPipeline::acquireFrame()
+{
+	if (ready.load() & FRESH_BIT)
+		front = ready.exchange(front) & INDEX_MASK;
+
+	return frames[front];
+}
+
+void SimulationPipeline::run()
+{
+	auto previousTime = std::chrono::steady_clock::now();
+
+	while (running)
+	{
+		// un cadru inainte cel mult: se asteapta ca desenarea sa preia cadrul publicat
+		if (paused || (ready.load() & FRESH_BIT))
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+			if (paused)
+				previousTime = std::chrono::steady_clock::now();
+			continue;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(stateMutex);
+
+			// acelasi pas de timp ca in Gui::update
+			auto currentTime = std::chrono::steady_clock::now();
+			std::chrono::duration<float> elapsed = currentTime - previousTime;
+			previousTime = currentTime;
+			float deltaT = std::min(elapsed.count() * 10.f, 0.15f);
+
+			pm.updateParticles(deltaT);
+			pm.captureFrame(frames[back]);
+		}
+
+		back = ready.exchange(back | FRESH_BIT) & INDEX_MASK;
+	}
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "ParticleManager.h"
+#include "RenderFrame.h"
+
+/**
+ * \class SimulationPipeline
+ * \brief Ruleaza simularea pe un fir separat, in timp ce firul de desenare deseneaza cadrul anterior.
+ *
+ * Firul de simulare actualizeaza particulele pentru cadrul N + 1 si scrie instantaneul (RenderFrame) intr-unul din
+ * cele trei buffere, in timp ce firul de desenare deseneaza instantaneul cadrului N. Bufferele se schimba fara blocari,
+ * printr-un singur indice atomic: simularea publica bufferul scris si primeste inapoi bufferul liber, iar desenarea
+ * preia ultimul buffer publicat. Dupa ce publica un cadru, simularea asteapta ca desenarea sa il preia, deci ruleaza
+ * cel mult un cadru inainte, iar durata unui cadru tinde spre max(simulare, desenare) in loc de suma lor.
+ *
+ * Cat timp pipeline-ul ruleaza, ParticleManager este folosit doar de firul de simulare; firul de desenare il modifica
+ * doar intre doi pasi, cu holdSimulation().
+ */
+class SimulationPipeline
+{
+public:
+    /**
+     * \brief Constructor.
+     * \param pm Managerul de particule simulat.
+     */
+    SimulationPipeline(ParticleManager& pm);
+
+    /**
+     * \brief Opreste firul de simulare, daca ruleaza.
+     */
+    ~SimulationPipeline();
+
+    SimulationPipeline(const SimulationPipeline&) = delete;
+    SimulationPipeline& operator=(const SimulationPipeline&) = delete;
+
+    /**
+     * \brief Copiaza starea curenta ca prim cadru de desenat si porneste firul de simulare.
+     */
+    void start();
+
+    /**
+     * \brief Opreste si asteapta firul de simulare.
+     */
+    void stop();
+
+    /**
+     * \brief Verifica daca firul de simulare ruleaza.
+     * \return `true` daca firul ruleaza.
+     */
+    bool isRunning() const;
+
+    /**
+     * \brief Opreste sau reia avansarea simularii, fara a opri firul.
+     * \param paused `true` pentru pauza.
+     */
+    void setPaused(bool paused);
+
+    /**
+     * \brief Opreste simularea intre doi pasi cat timp lock-ul intors exista.
+     *
+     * Se foloseste pe firul de desenare inainte de orice modificare a ParticleManager (numarul de particule,
+     * algoritmul, viteza). Daca pipeline-ul nu ruleaza, lock-ul este obtinut imediat.
+     * \return Lock-ul care tine simularea.
+     */
+    std::unique_lock<std::mutex> holdSimulation();
+
+    /**
+     * \brief Preia cel mai recent cadru publicat de simulare (sau pastreaza cadrul curent daca nu exista unul nou).
+     *
+     * Instantaneul intors ramane neschimbat pana la urmatorul apel, de pe acelasi fir.
+     * \return Instantaneul de desenat.
+     */
+    const RenderFrame& acquireFrame();
+
+private:
+    /**
+     * \brief Bucla firului de simulare.
+     */
+    void run();
+
+    static const int INDEX_MASK = 3;   ///< Bitii indicelui de buffer din ready.
+    static const int FRESH_BIT = 4;    ///< Setat cand bufferul din ready a fost publicat si nu a fost inca preluat.
+
+    ParticleManager& pm;                      ///< Managerul de particule simulat.
+    std::array<RenderFrame, 3> frames;        ///< Cele trei buffere: desenat, publicat si in scriere.
+    std::atomic<int> ready{ 2 };              ///< Bufferul publicat, plus FRESH_BIT.
+    int front = 0;                            ///< Bufferul desenat (folosit doar de firul de desenare).
+    int back = 1;                             ///< Bufferul in scriere (folosit doar de firul de simulare).
+    std::thread thread;                       ///< Firul de simulare.
+    std::atomic<bool> running{ false };       ///< Indicator pentru oprirea firului.
+    std::atomic<bool> paused{ false };        ///< Indicator pentru pauza.
+    std::mutex stateMutex;                    ///< Tinut de firul de simulare pe durata fiecarui pas.
+};
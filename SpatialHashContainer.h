@@ -0,0 +1,269 @@
+#pragma once
+#include <raylib.h>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include "GridContainer.h"
+
+/// \class SpatialHashContainer
+/// \brief Retea rara: doar celulele ocupate sunt stocate, intr-o tabela de dispersie cu adresare deschisa.
+///
+/// Cheia unei celule este perechea de coordonate intregi (cellX, cellY), fara limite ale lumii, deci particulele pot fi
+/// oriunde, iar celulele goale nu ocupa memorie. La fiecare update() tabela este reconstruita: fiecare celula ocupata
+/// primeste un indice dens (in ordinea primei particule din ea), apoi ID-urile particulelor sunt asezate, printr-o
+/// sortare prin numarare, intr-un singur vector (cellItems), cu cellStart[c] pozitia primului element al celulei c.
+///
+/// Latura celulei este percentila GridOptions::cellSizePercentile a diametrelor particulelor si se recalculeaza cand
+/// raza maxima se schimba; ca la GridContainer, cautarea acopera atatea inele de celule cate cere diametrul maxim.
+/// \tparam T Tipul stocarii de particule (de exemplu ParticleStore).
+template <typename T>
+class SpatialHashContainer
+{
+public:
+    /// \brief Constructor.
+    /// \param options Parametrii retelei (se folosesc cellSizePercentile si autoCellSize).
+    explicit SpatialHashContainer(const GridOptions& options = GridOptions()) : options(options)
+    {
+
+    }
+
+    /// \brief Reconstruieste tabela din pozitiile particulelor.
+    /// \param particles Stocarea particulelor, indexata dupa ID-ul dens al particulei.
+    void update(const T& particles)
+    {
+        int particleCount = (int)particles.size();
+
+        float largestRadius = maxParticleRadius(particles);
+        if (largestRadius != tunedMaxRadius)
+        {
+            tunedMaxRadius = largestRadius;
+            float percentile = options.autoCellSize ? options.cellSizePercentile : 100.f;
+            cellSize = std::max(diameterPercentile(particles, percentile, diameters), 1.f);
+        }
+        reach = std::max(1, static_cast<int>(std::ceil(2.f * largestRadius / cellSize)));
+
+        // cel mult o celula pentru fiecare particula, deci tabela este cel mult pe jumatate plina
+        size_t capacity = 16;
+        while (capacity < 2 * static_cast<size_t>(particleCount))
+            capacity *= 2;
+        tableKeys.resize(capacity);
+        tableCells.assign(capacity, -1);
+        tableMask = capacity - 1;
+
+        cellX.clear();
+        cellY.clear();
+        cellStart.assign(1, 0);
+        particleCell.resize(particleCount);
+
+        // 1. celula fiecarei particule si numarul de particule din fiecare celula (in cellStart[c + 1])
+        for (int id = 0; id < particleCount; id++)
+        {
+            int x = static_cast<int>(std::floor(particles.x[id] / cellSize));
+            int y = static_cast<int>(std::floor(particles.y[id] / cellSize));
+
+            int cell = findOrInsertCell(x, y);
+            particleCell[id] = cell;
+            cellStart[cell + 1]++;
+        }
+
+        // 2. suma prefixelor si asezarea ID-urilor
+        int cellCount = (int)cellX.size();
+        for (int c = 0; c < cellCount; c++)
+            cellStart[c + 1] += cellStart[c];
+
+        cellFill.assign(cellStart.begin(), cellStart.end() - 1);
+        cellItems.resize(particleCount);
+        for (int id = 0; id < particleCount; id++)
+            cellItems[cellFill[particleCell[id]]++] = id;
+    }
+
+    /// \brief Apeleaza visit pentru fiecare element din celula elementului specificat si din celulele vecine, fara alocari.
+    ///
+    /// Elementul insusi este si el vizitat.
+    /// \param id Identificatorul elementului de interogat.
+    /// \param visit Functia apelata cu identificatorul fiecarui element gasit.
+    template <typename Visitor>
+    void forEachNeighbour(int id, Visitor&& visit) const
+    {
+        if (id < 0 || id >= (int)particleCell.size())
+            return;
+
+        int cell = particleCell[id];
+        for (int dy = -reach; dy <= reach; dy++)
+        {
+            for (int dx = -reach; dx <= reach; dx++)
+            {
+                int other = findCell(cellX[cell] + dx, cellY[cell] + dy);
+                if (other < 0)
+                    continue;
+
+                for (int i = cellStart[other]; i < cellStart[other + 1]; i++)
+                    visit(cellItems[i]);
+            }
+        }
+    }
+
+    /// \brief Apeleaza visit o singura data pentru fiecare pereche de elemente aflate in aceeasi celula sau in celule vecine, fara alocari.
+    ///
+    /// Ca la GridContainer::forEachCandidatePair, fiecare celula ocupata este combinata cu ea insasi si cu jumatatea
+    /// "inainte" a vecinatatii (dreapta pe acelasi rand, apoi randurile de dedesubt); celulele vecine goale nu exista
+    /// in tabela si sunt sarite.
+    /// \param visit Functia apelata cu cele doua ID-uri ale fiecarei perechi.
+    template <typename Visitor>
+    void forEachCandidatePair(Visitor&& visit) const
+    {
+        int cellCount = (int)cellX.size();
+        for (int cell = 0; cell < cellCount; cell++)
+            forEachCandidatePairInCell(cell, visit);
+    }
+
+    /// \brief Apeleaza visit pentru perechile pe care forEachCandidatePair le formeaza pornind de la o singura celula ocupata.
+    ///
+    /// Fiecare pereche este formata de o singura celula, deci celule diferite pot fi parcurse in paralel.
+    /// \param cell Indicele dens al celulei (mai mic decat getCellCount()).
+    /// \param visit Functia apelata cu cele doua ID-uri ale fiecarei perechi.
+    template <typename Visitor>
+    void forEachCandidatePairInCell(int cell, Visitor&& visit) const
+    {
+        int begin = cellStart[cell];
+        int end = cellStart[cell + 1];
+
+        for (int i = begin; i < end; i++)
+            for (int j = i + 1; j < end; j++)
+                visit(cellItems[i], cellItems[j]);
+
+        for (int dy = 0; dy <= reach; dy++)
+        {
+            for (int dx = (dy == 0 ? 1 : -reach); dx <= reach; dx++)
+            {
+                int other = findCell(cellX[cell] + dx, cellY[cell] + dy);
+                if (other < 0)
+                    continue;
+
+                for (int i = begin; i < end; i++)
+                    for (int j = cellStart[other]; j < cellStart[other + 1]; j++)
+                        visit(cellItems[i], cellItems[j]);
+            }
+        }
+    }
+
+    /// \brief Obtine numarul de celule ocupate.
+    /// \return Numarul de celule ocupate.
+    int getCellCount() const
+    {
+        return (int)cellX.size();
+    }
+
+    /// \brief Obtine dreptunghiul unei celule ocupate.
+    /// \param cell Indicele dens al celulei (mai mic decat getCellCount()).
+    /// \return Dreptunghiul celulei.
+    Rectangle getCellRectangle(int cell) const
+    {
+        return Rectangle{ cellX[cell] * cellSize, cellY[cell] * cellSize, cellSize, cellSize };
+    }
+
+    /// \brief Obtine latura unei celule.
+    /// \return Latura unei celule.
+    float getCellSize() const
+    {
+        return cellSize;
+    }
+
+    /// \brief Obtine numarul de inele de celule vecine cautate.
+    /// \return Numarul de inele (1 = vecinatatea 3x3).
+    int getReach() const
+    {
+        return reach;
+    }
+
+    /// \brief Obtine numarul de intrari ale tabelei de dispersie.
+    /// \return Capacitatea tabelei.
+    size_t getTableCapacity() const
+    {
+        return tableCells.size();
+    }
+
+    /// \brief Calculeaza dimensiunea totala a structurii de date.
+    /// \return Dimensiunea totala a structurii de date in bytes.
+    size_t sizeOfDataStructure() const
+    {
+        size_t count = 0;
+        count += tableKeys.size() * sizeof(uint64_t);
+        count += (tableCells.size() + cellX.size() + cellY.size()) * sizeof(int);
+        count += (cellStart.size() + cellFill.size() + cellItems.size() + particleCell.size()) * sizeof(int);
+        count += diameters.size() * sizeof(float);
+        count += sizeof(cellSize) + sizeof(reach);
+
+        return count;
+    }
+
+private:
+    /// \brief Calculeaza cheia unei celule.
+    /// \param x Coordonata X a celulei.
+    /// \param y Coordonata Y a celulei.
+    /// \return Cheia de 64 de biti.
+    static uint64_t cellKey(int x, int y)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    }
+
+    /// \brief Calculeaza pozitia de start a unei chei in tabela (dispersie Fibonacci).
+    /// \param key Cheia celulei.
+    /// \return Pozitia in tabela.
+    size_t slotFor(uint64_t key) const
+    {
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & tableMask;
+    }
+
+    /// \brief Cauta o celula in tabela.
+    /// \param x Coordonata X a celulei.
+    /// \param y Coordonata Y a celulei.
+    /// \return Indicele dens al celulei, sau -1 daca celula nu este ocupata.
+    int findCell(int x, int y) const
+    {
+        uint64_t key = cellKey(x, y);
+        for (size_t slot = slotFor(key); tableCells[slot] >= 0; slot = (slot + 1) & tableMask)
+            if (tableKeys[slot] == key)
+                return tableCells[slot];
+
+        return -1;
+    }
+
+    /// \brief Cauta o celula in tabela si o adauga daca nu exista.
+    /// \param x Coordonata X a celulei.
+    /// \param y Coordonata Y a celulei.
+    /// \return Indicele dens al celulei.
+    int findOrInsertCell(int x, int y)
+    {
+        uint64_t key = cellKey(x, y);
+        size_t slot = slotFor(key);
+        for (; tableCells[slot] >= 0; slot = (slot + 1) & tableMask)
+            if (tableKeys[slot] == key)
+                return tableCells[slot];
+
+        int cell = (int)cellX.size();
+        tableKeys[slot] = key;
+        tableCells[slot] = cell;
+        cellX.push_back(x);
+        cellY.push_back(y);
+        cellStart.push_back(0);
+
+        return cell;
+    }
+
+    GridOptions options;                ///< Parametrii retelei.
+    float cellSize = 1.f;               ///< Latura unei celule.
+    int reach = 1;                      ///< Numarul de inele de celule vecine cautate.
+    float tunedMaxRadius = -1.f;        ///< Raza maxima pentru care a fost aleasa latura celulei (-1 = inca nealeasa).
+    std::vector<float> diameters;       ///< Diametrele particulelor, refolosite la alegerea laturii celulei.
+    std::vector<uint64_t> tableKeys;    ///< Cheile celulelor din tabela de dispersie.
+    std::vector<int> tableCells;        ///< Indicele dens al celulei din fiecare intrare a tabelei (-1 = intrare goala).
+    size_t tableMask = 0;               ///< Capacitatea tabelei minus 1 (capacitatea este o putere a lui 2).
+    std::vector<int> cellX;             ///< Coordonata X a fiecarei celule ocupate.
+    std::vector<int> cellY;             ///< Coordonata Y a fiecarei celule ocupate.
+    std::vector<int> cellStart;         ///< Pozitia primului element al fiecarei celule in cellItems, plus numarul total la final.
+    std::vector<int> cellFill;          ///< Pozitia urmatoare de scris pentru fiecare celula, folosita in timpul reconstructiei.
+    std::vector<int> cellItems;         ///< ID-urile tuturor elementelor, sortate dupa celula.
+    std::vector<int> particleCell;      ///< Indicele dens al celulei fiecarei particule.
+};
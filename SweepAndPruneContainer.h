@@ -0,0 +1,203 @@
+#pragma once
+#include <raylib.h>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+
+#define SAP_MAX_SHIFTS_PER_PARTICLE 8
+
+/// \class SweepAndPruneContainer
+/// \brief Faza larga prin sortare si baleiere (sweep and prune) pe axa X.
+///
+/// ID-urile particulelor sunt pastrate sortate dupa marginea stanga a intervalului lor pe axa X (x - raza). Intre
+/// doua cadre particulele se deplaseaza putin, deci ordinea ramane aproape sortata si update() o repara printr-o
+/// sortare prin insertie, in timp aproape liniar. Ordinea completa se reface cu std::sort dupa reset(), cand se
+/// schimba numarul de particule sau cand sortarea prin insertie depaseste SAP_MAX_SHIFTS_PER_PARTICLE deplasari pe
+/// particula (particulele au fost mutate mult, de exemplu regenerate), caz in care ar deveni patratica.
+///
+/// La baleiere, fiecare particula este comparata doar cu urmatoarele din ordine, pana la prima al carei interval
+/// incepe dupa sfarsitul intervalului ei; dintre acestea, sunt perechi candidate cele ale caror intervale se
+/// suprapun si pe axa Y.
+/// \tparam T Tipul stocarii de particule (de exemplu ParticleStore).
+template <typename T>
+class SweepAndPruneContainer
+{
+public:
+    /// \brief Actualizeaza ordinea particulelor dupa pozitiile curente.
+    /// \param particles Stocarea particulelor, indexata dupa ID-ul dens al particulei.
+    void update(const T& particles)
+    {
+        int particleCount = (int)particles.size();
+
+        lastSwapCount = 0;
+        if (particleCount != (int)order.size())
+        {
+            order.resize(particleCount);
+            std::iota(order.begin(), order.end(), 0);
+            sortOrder(particles);
+        }
+        else
+        {
+            minX.resize(particleCount);
+            for (int i = 0; i < particleCount; i++)
+                minX[i] = particles.x[order[i]] - particles.radius[order[i]];
+
+            if (insertionSort())
+            {
+                totalSwapCount += lastSwapCount;
+                incrementalUpdates++;
+            }
+            else
+                sortOrder(particles);
+        }
+
+        // restul intervalelor, in ordinea sortata, ca baleierea sa citeasca memoria secvential
+        maxX.resize(particleCount);
+        minY.resize(particleCount);
+        maxY.resize(particleCount);
+        for (int i = 0; i < particleCount; i++)
+        {
+            int id = order[i];
+            maxX[i] = particles.x[id] + particles.radius[id];
+            minY[i] = particles.y[id] - particles.radius[id];
+            maxY[i] = particles.y[id] + particles.radius[id];
+        }
+    }
+
+    /// \brief Uita ordinea curenta, astfel incat urmatorul update() sorteaza complet particulele.
+    ///
+    /// Trebuie apelata cand particulele sunt regenerate; altfel sortarea prin insertie ar porni de la o ordine fara
+    /// legatura cu noile pozitii.
+    void reset()
+    {
+        order.clear();
+        lastSwapCount = 0;
+        totalSwapCount = 0;
+        incrementalUpdates = 0;
+    }
+
+    /// \brief Apeleaza visit o singura data pentru fiecare pereche de elemente ale caror dreptunghiuri se suprapun, fara alocari.
+    /// \param visit Functia apelata cu cele doua ID-uri ale fiecarei perechi.
+    template <typename Visitor>
+    void forEachCandidatePair(Visitor&& visit) const
+    {
+        forEachCandidatePairInRange(0, (int)order.size(), visit);
+    }
+
+    /// \brief Apeleaza visit pentru perechile pe care forEachCandidatePair le formeaza pornind de la un interval din ordinea sortata.
+    ///
+    /// Fiecare pereche este formata de pozitia mai mica din ordine, deci intervale disjuncte pot fi parcurse in paralel.
+    /// \param begin Prima pozitie din getOrder().
+    /// \param end Pozitia de dupa ultima.
+    /// \param visit Functia apelata cu cele doua ID-uri ale fiecarei perechi.
+    template <typename Visitor>
+    void forEachCandidatePairInRange(int begin, int end, Visitor&& visit) const
+    {
+        int particleCount = (int)order.size();
+        for (int i = begin; i < end; i++)
+        {
+            for (int j = i + 1; j < particleCount && minX[j] <= maxX[i]; j++)
+            {
+                if (minY[j] <= maxY[i] && minY[i] <= maxY[j])
+                    visit(order[i], order[j]);
+            }
+        }
+    }
+
+    /// \brief Obtine ID-urile particulelor, sortate dupa marginea stanga a intervalului pe axa X.
+    /// \return Ordinea curenta a particulelor.
+    const std::vector<int>& getOrder() const
+    {
+        return order;
+    }
+
+    /// \brief Obtine intervalul pe axa X al unei pozitii din ordinea sortata.
+    /// \param index Pozitia in getOrder().
+    /// \return Marginea stanga (x) si cea dreapta (y) a intervalului.
+    Vector2 getInterval(int index) const
+    {
+        return Vector2{ minX[index], maxX[index] };
+    }
+
+    /// \brief Obtine numarul de deplasari facute de sortarea prin insertie la ultimul update().
+    /// \return Numarul de deplasari (0 daca ordinea era deja sortata).
+    long long getLastSwapCount() const
+    {
+        return lastSwapCount;
+    }
+
+    /// \brief Obtine numarul mediu de deplasari ale sortarii prin insertie, de la ultimul reset().
+    ///
+    /// Sunt numarate doar actualizarile incrementale, nu si sortarile complete.
+    /// \return Media deplasarilor pe actualizare (0 daca nu a existat nicio actualizare incrementala).
+    double getMeanSwapCount() const
+    {
+        return incrementalUpdates > 0 ? static_cast<double>(totalSwapCount) / incrementalUpdates : 0.0;
+    }
+
+    /// \brief Calculeaza dimensiunea totala a structurii de date.
+    /// \return Dimensiunea totala a structurii de date in bytes.
+    size_t sizeOfDataStructure() const
+    {
+        size_t count = 0;
+        count += order.size() * sizeof(int);
+        count += (minX.size() + maxX.size() + minY.size() + maxY.size()) * sizeof(float);
+        count += sizeof(lastSwapCount) + sizeof(totalSwapCount) + sizeof(incrementalUpdates);
+
+        return count;
+    }
+
+private:
+    /// \brief Sorteaza complet order dupa marginea stanga a intervalelor si recalculeaza minX.
+    /// \param particles Stocarea particulelor.
+    void sortOrder(const T& particles)
+    {
+        std::sort(order.begin(), order.end(), [&](int first, int second)
+        {
+            return particles.x[first] - particles.radius[first] < particles.x[second] - particles.radius[second];
+        });
+
+        minX.resize(order.size());
+        for (size_t i = 0; i < order.size(); i++)
+            minX[i] = particles.x[order[i]] - particles.radius[order[i]];
+    }
+
+    /// \brief Sorteaza prin insertie order si minX, pornind de la ordinea din cadrul anterior (aproape sortata).
+    /// \return `false` daca sortarea a fost abandonata dupa prea multe deplasari (order ramane o permutare valida).
+    bool insertionSort()
+    {
+        int particleCount = (int)order.size();
+        long long maxShifts = static_cast<long long>(SAP_MAX_SHIFTS_PER_PARTICLE) * particleCount;
+
+        for (int i = 1; i < particleCount; i++)
+        {
+            float key = minX[i];
+            int id = order[i];
+
+            int j = i - 1;
+            while (j >= 0 && minX[j] > key)
+            {
+                minX[j + 1] = minX[j];
+                order[j + 1] = order[j];
+                j--;
+            }
+            minX[j + 1] = key;
+            order[j + 1] = id;
+            lastSwapCount += i - 1 - j;
+
+            if (lastSwapCount > maxShifts)
+                return false;
+        }
+
+        return true;
+    }
+
+    std::vector<int> order;         ///< ID-urile particulelor, sortate dupa minX.
+    std::vector<float> minX;        ///< Marginea stanga a intervalului pe X, pentru fiecare pozitie din order.
+    std::vector<float> maxX;        ///< Marginea dreapta a intervalului pe X, pentru fiecare pozitie din order.
+    std::vector<float> minY;        ///< Marginea de sus a intervalului pe Y, pentru fiecare pozitie din order.
+    std::vector<float> maxY;        ///< Marginea de jos a intervalului pe Y, pentru fiecare pozitie din order.
+    long long lastSwapCount = 0;    ///< Numarul de deplasari facute de sortarea prin insertie la ultimul update().
+    long long totalSwapCount = 0;   ///< Suma deplasarilor actualizarilor incrementale de la ultimul reset().
+    int incrementalUpdates = 0;     ///< Numarul de actualizari incrementale de la ultimul reset().
+};
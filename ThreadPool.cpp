@@ -0,0 +1,255 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace
+{
+	thread_local const ThreadPool* currentPool = nullptr;   // pool-ul caruia ii apartine firul curent
+	thread_local size_t currentWorker = 0;                  // indexul firului curent in pool
+}
+
+constexpr std::chrono::microseconds ThreadPool::SPIN_TIME;
+
+ThreadPool::ThreadPool(size_t workerCount)
+{
+	startWorkers(workerCount);
+}
+
+ThreadPool::~ThreadPool()
+{
+	stopWorkers();
+}
+
+void ThreadPool::setWorkerCount(size_t workerCount)
+{
+	if (workerCount == workers.size())
+		return;
+
+	stopWorkers();
+	startWorkers(workerCount);
+}
+
+void ThreadPool::startWorkers(size_t workerCount)
+{
+	stopping = false;
+
+	queues.clear();
+	for (size_t i = 0; i < workerCount + 1; i++)
+		queues.push_back(std::make_unique<TaskQueue>());
+
+	workers.reserve(workerCount);
+	for (size_t i = 0; i < workerCount; i++)
+		workers.emplace_back([this, i]
+		{
+			currentPool = this;
+			currentWorker = i;
+			workerLoop();
+		});
+}
+
+void ThreadPool::stopWorkers()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wakeCondition.notify_all();
+
+	for (auto& worker : workers)
+		worker.join();
+	workers.clear();
+}
+
+size_t ThreadPool::defaultWorkerCount()
+{
+	unsigned int cores = std::thread::hardware_concurrency();
+	return cores > 1 ? cores - 1 : 0;
+}
+
+size_t ThreadPool::getThreadCount() const
+{
+	return workers.size() + 1;
+}
+
+void ThreadPool::parallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t, size_t)>& body)
+{
+	if (begin >= end)
+		return;
+
+	grainSize = std::max<size_t>(grainSize, 1);
+	size_t chunks = (end - begin + grainSize - 1) / grainSize;
+
+	// nu merita trezite firele pentru o singura bucata
+	if (workers.empty() || chunks == 1)
+	{
+		body(begin, end);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		job = &body;
+		jobBegin = begin;
+		jobEnd = end;
+		jobGrain = grainSize;
+		chunkCount = chunks;
+		nextChunk = 0;
+		chunksDone = 0;
+		generation++;
+	}
+	wakeCondition.notify_all();
+
+	// firul apelant lucreaza si el
+	runChunks();
+
+	std::unique_lock<std::mutex> lock(mutex);
+	doneCondition.wait(lock, [this] { return chunksDone == chunkCount && activeWorkers == 0; });
+	job = nullptr;
+}
+
+void ThreadPool::submit(TaskGroup& group, std::function<void()> task)
+{
+	group.pending.fetch_add(1);
+
+	TaskQueue& queue = *queues[currentQueue()];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.tasks.push_back(Task{ std::move(task), &group });
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		queuedTasks.fetch_add(1);
+	}
+	wakeCondition.notify_one();
+}
+
+void ThreadPool::wait(TaskGroup& group)
+{
+	Task task;
+	while (group.pending.load() > 0)
+	{
+		if (takeTask(task))
+			runTask(task);
+		else
+			std::this_thread::yield();
+	}
+}
+
+size_t ThreadPool::currentQueue() const
+{
+	return currentPool == this ? currentWorker : workers.size();
+}
+
+bool ThreadPool::takeTask(Task& task)
+{
+	if (queuedTasks.load() == 0)
+		return false;
+
+	size_t own = currentQueue();
+
+	// coada proprie: cea mai recenta sarcina
+	{
+		TaskQueue& queue = *queues[own];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.tasks.empty())
+		{
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+			queuedTasks.fetch_sub(1);
+			return true;
+		}
+	}
+
+	// furt: cea mai veche sarcina din coada altui fir
+	for (size_t offset = 1; offset < queues.size(); offset++)
+	{
+		TaskQueue& queue = *queues[(own + offset) % queues.size()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.tasks.empty())
+		{
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+			queuedTasks.fetch_sub(1);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void ThreadPool::runTask(Task& task)
+{
+	task.function();
+	task.function = nullptr;
+	task.group->pending.fetch_sub(1);
+}
+
+void ThreadPool::workerLoop()
+{
+	uint64_t seenGeneration = generation.load();
+
+	while (true)
+	{
+		spinForWork(seenGeneration);
+
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+
+			// lucrarile terminate fara acest fir nu mai trebuie asteptate
+			if (job == nullptr)
+				seenGeneration = generation;
+
+			wakeCondition.wait(lock, [&] { return stopping || (generation != seenGeneration && job != nullptr) || queuedTasks.load() > 0; });
+			if (stopping)
+				return;
+
+			if (generation == seenGeneration || job == nullptr)
+			{
+				lock.unlock();
+
+				// doar sarcini in cozi
+				Task task;
+				while (takeTask(task))
+					runTask(task);
+				continue;
+			}
+
+			seenGeneration = generation;
+			activeWorkers++;
+		}
+
+		runChunks();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			activeWorkers--;
+		}
+		doneCondition.notify_one();
+	}
+}
+
+bool ThreadPool::spinForWork(uint64_t seenGeneration) const
+{
+	auto deadline = std::chrono::steady_clock::now() + SPIN_TIME;
+	do
+	{
+		if (stopping.load() || generation.load() != seenGeneration || queuedTasks.load() > 0)
+			return true;
+
+		std::this_thread::yield();
+	} while (std::chrono::steady_clock::now() < deadline);
+
+	return false;
+}
+
+void ThreadPool::runChunks()
+{
+	size_t chunk;
+	while ((chunk = nextChunk.fetch_add(1)) < chunkCount)
+	{
+		size_t chunkBegin = jobBegin + chunk * jobGrain;
+		size_t chunkEnd = std::min(chunkBegin + jobGrain, jobEnd);
+		(*job)(chunkBegin, chunkEnd);
+		chunksDone.fetch_add(1);
+	}
+}
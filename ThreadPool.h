@@ -0,0 +1,194 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \class ThreadPool
+ * \brief Un set persistent de fire de executie pentru bucle paralele.
+ *
+ * Firele sunt create o singura data, in constructor, si asteapta lucru intre cadre. Un apel
+ * parallelFor imparte intervalul in bucati de dimensiune fixa; bucatile sunt luate pe rand de
+ * firele din pool si de firul apelant, iar apelul se intoarce doar dupa ce toate bucatile au fost procesate.
+ * parallelFor nu este reentrant: nu se apeleaza din interiorul corpului unei bucle paralele.
+ *
+ * Pentru lucrul recursiv (de exemplu constructia BVH) pool-ul accepta si sarcini independente, grupate intr-un
+ * TaskGroup. Fiecare fir are propria coada: sarcinile create de un fir se adauga la sfarsitul cozii sale si sunt
+ * luate tot de la sfarsit (cele mai recente, cu datele inca in cache), iar un fir fara lucru fura de la inceputul
+ * cozii altui fir (cele mai vechi, de obicei cele mai mari). Un fir care asteapta un TaskGroup executa sarcini
+ * in loc sa stea blocat, deci o sarcina poate crea si astepta la randul ei alte sarcini.
+ *
+ * Dupa ce termina o lucrare, un fir mai asteapta activ putin timp (SPIN_TIME) inainte sa adoarma, astfel incat
+ * pasii paraleli consecutivi ai aceluiasi cadru nu platesc de fiecare data trezirea prin condition_variable.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * \brief Construieste pool-ul si porneste firele.
+     * \param workerCount Numarul de fire suplimentare (firul apelant participa si el la lucru).
+     */
+    explicit ThreadPool(size_t workerCount = defaultWorkerCount());
+
+    /**
+     * \brief Opreste si asteapta toate firele.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * \brief Numarul implicit de fire suplimentare (numarul de nuclee minus firul apelant).
+     * \return Numarul de fire suplimentare.
+     */
+    static size_t defaultWorkerCount();
+
+    /**
+     * \brief Opreste firele existente si porneste workerCount fire noi.
+     *
+     * Nu se apeleaza in timpul unui parallelFor sau cat timp exista sarcini neterminate.
+     * \param workerCount Numarul de fire suplimentare (0 = tot lucrul se face pe firul apelant).
+     */
+    void setWorkerCount(size_t workerCount);
+
+    /**
+     * \brief Returneaza numarul total de fire care executa lucru (firele din pool plus firul apelant).
+     * \return Numarul de fire.
+     */
+    size_t getThreadCount() const;
+
+    /**
+     * \brief Executa body pe intervalul [begin, end), impartit in bucati de cel mult grainSize elemente.
+     * \param begin Inceputul intervalului.
+     * \param end Sfarsitul intervalului (exclusiv).
+     * \param grainSize Dimensiunea unei bucati.
+     * \param body Functia apelata cu capetele fiecarei bucati, (chunkBegin, chunkEnd).
+     */
+    void parallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t, size_t)>& body);
+
+    /**
+     * \class TaskGroup
+     * \brief Un grup de sarcini care pot fi asteptate impreuna.
+     */
+    class TaskGroup
+    {
+    public:
+        TaskGroup() = default;
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+    private:
+        friend class ThreadPool;
+        std::atomic<size_t> pending{ 0 }; ///< Sarcinile din grup care nu s-au terminat inca.
+    };
+
+    /**
+     * \brief Adauga o sarcina in coada firului curent. Poate fi apelat si din interiorul unei sarcini.
+     * \param group Grupul din care face parte sarcina.
+     * \param task Sarcina.
+     */
+    void submit(TaskGroup& group, std::function<void()> task);
+
+    /**
+     * \brief Asteapta terminarea tuturor sarcinilor din grup, executand intre timp sarcini din cozi.
+     * \param group Grupul asteptat.
+     */
+    void wait(TaskGroup& group);
+
+private:
+    /**
+     * \struct Task
+     * \brief O sarcina impreuna cu grupul ei.
+     */
+    struct Task
+    {
+        std::function<void()> function; ///< Corpul sarcinii.
+        TaskGroup* group;               ///< Grupul sarcinii.
+    };
+
+    /**
+     * \struct TaskQueue
+     * \brief Coada de sarcini a unui fir.
+     */
+    struct TaskQueue
+    {
+        std::mutex mutex;        ///< Protejeaza coada.
+        std::deque<Task> tasks;  ///< Sarcinile, cea mai recenta la sfarsit.
+    };
+
+    /**
+     * \brief Returneaza indexul cozii firului curent (firele din afara pool-ului folosesc ultima coada).
+     * \return Indexul cozii.
+     */
+    size_t currentQueue() const;
+
+    /**
+     * \brief Ia o sarcina din coada proprie sau, daca e goala, fura una din coada altui fir.
+     * \param task Sarcina gasita.
+     * \return `true` daca s-a gasit o sarcina.
+     */
+    bool takeTask(Task& task);
+
+    /**
+     * \brief Executa o sarcina si marcheaza terminarea ei in grup.
+     * \param task Sarcina.
+     */
+    void runTask(Task& task);
+
+    /**
+     * \brief Porneste firele din pool si cozile lor.
+     * \param workerCount Numarul de fire suplimentare.
+     */
+    void startWorkers(size_t workerCount);
+
+    /**
+     * \brief Opreste si asteapta toate firele din pool.
+     */
+    void stopWorkers();
+
+    /**
+     * \brief Bucla executata de fiecare fir din pool.
+     */
+    void workerLoop();
+
+    /**
+     * \brief Asteapta activ, cel mult SPIN_TIME, o lucrare noua, o sarcina in cozi sau oprirea pool-ului.
+     * \param seenGeneration Ultima lucrare vazuta de firul curent.
+     * \return `true` daca a aparut ceva de facut inainte de expirarea timpului.
+     */
+    bool spinForWork(uint64_t seenGeneration) const;
+
+    static constexpr std::chrono::microseconds SPIN_TIME{ 200 };   ///< Cat asteapta activ un fir inainte sa adoarma.
+
+    /**
+     * \brief Proceseaza bucati din lucrarea curenta pana cand nu mai raman bucati libere.
+     */
+    void runChunks();
+
+    std::vector<std::thread> workers;                               ///< Firele din pool.
+    std::mutex mutex;                                               ///< Protejeaza descrierea lucrarii curente.
+    std::condition_variable wakeCondition;                          ///< Trezeste firele cand apare o lucrare noua.
+    std::condition_variable doneCondition;                          ///< Anunta firul apelant ca lucrarea s-a terminat.
+
+    const std::function<void(size_t, size_t)>* job = nullptr;       ///< Corpul buclei curente.
+    size_t jobBegin = 0;                                            ///< Inceputul intervalului curent.
+    size_t jobEnd = 0;                                              ///< Sfarsitul intervalului curent.
+    size_t jobGrain = 1;                                            ///< Dimensiunea unei bucati.
+    size_t chunkCount = 0;                                          ///< Numarul de bucati din lucrarea curenta.
+    std::atomic<size_t> nextChunk{ 0 };                             ///< Urmatoarea bucata libera.
+    std::atomic<size_t> chunksDone{ 0 };                            ///< Numarul de bucati terminate.
+    size_t activeWorkers = 0;                                       ///< Firele care lucreaza inca la lucrarea curenta.
+    std::atomic<uint64_t> generation{ 0 };                          ///< Se incrementeaza la fiecare lucrare noua.
+    std::atomic<bool> stopping{ false };                            ///< Indicator pentru oprirea firelor.
+
+    std::vector<std::unique_ptr<TaskQueue>> queues;                 ///< Cate o coada pentru fiecare fir din pool, plus una pentru firele din afara.
+    std::atomic<size_t> queuedTasks{ 0 };                           ///< Numarul de sarcini aflate in cozi.
+};
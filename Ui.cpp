@@ -73,14 +73,75 @@ void Ui::gridCommands(std::vector<std::string>& tokens)
     }
 }
 
+void Ui::sweepAndPruneCommands(std::vector<std::string>& tokens)
+{
+    if (tokens.size() == 2)
+    {
+        pm.startSweepAndPrune();
+        int number = std::stoi(tokens[1]);
+        pm.updateNumberOfParticles(number);
+    }
+    if (tokens.size() == 3)
+    {
+        if (tokens[1] == "velocity" || tokens[1] == "speed")
+        {
+            float number = std::stof(tokens[2]);
+            pm.updateParticleVelocity(number);
+        }
+    }
+}
+
+void Ui::bruteForceCommands(std::vector<std::string>& tokens)
+{
+    if (tokens.size() == 2)
+    {
+        pm.startBruteForce();
+        int number = std::stoi(tokens[1]);
+        pm.updateNumberOfParticles(number);
+    }
+    if (tokens.size() == 3)
+    {
+        if (tokens[1] == "velocity" || tokens[1] == "speed")
+        {
+            float number = std::stof(tokens[2]);
+            pm.updateParticleVelocity(number);
+        }
+    }
+}
+
+void Ui::workersCommands(std::vector<std::string>& tokens)
+{
+    if (tokens.size() == 2)
+    {
+        int number = std::stoi(tokens[1]);
+        if (number >= 0)
+            pm.setWorkerCount(number);
+    }
+    std::cout << "Threads per frame: " << pm.getThreadCount() << "\n";
+}
+
+void Ui::lineDepthCommands(std::vector<std::string>& tokens)
+{
+    if (tokens.size() == 2)
+    {
+        int number = std::stoi(tokens[1]);
+        if (number >= 0)
+            pm.setLineDepthLimit(number);
+    }
+}
+
 void Ui::helpCommands(std::vector<std::string>& tokens)
 {
     std::cout << "help\n";
-    std::cout << "quadtree/bvh/grid [number] - changes the number of particles\n";
-    std::cout << "quadtree/bvh/grid velocity [number] - multiplies with the velocity of particles\n";
+    std::cout << "quadtree/bvh/grid/sap/bruteforce [number] - changes the number of particles\n";
+    std::cout << "quadtree/bvh/grid/sap/bruteforce velocity [number] - multiplies with the velocity of particles\n";
+    std::cout << "workers [number] - sets the number of worker threads used besides the main thread\n";
+    std::cout << "linedepth [number] - draws only the first levels of the quadtree/bvh when lines are on (0 = all levels)\n";
     std::cout << "exit - closes the program\n";
     std::cout << "start - start the simulation\n";
     std::cout << "gui - start the gui\n";
+    std::cout << "gui pipelined - start the gui, simulating the next frame on another thread while the current one is drawn\n";
+    std::cout << "gui [pipelined] circles/sprites/instanced - draws the particles one circle at a time, as batched textured quads, or with one instanced draw call (default)\n";
     std::cout << "test - start the simulation for all algorithms\n";
 }
 
@@ -106,6 +167,25 @@ void Ui::guiCommands(std::vector<std::string>& tokens)
     if (!gui)
         gui = std::make_unique<Gui>(pm);
 
+    bool pipelined = false;
+    ParticleRenderMode renderMode = ParticleRenderMode::Instanced;
+    for (size_t i = 1; i < tokens.size(); i++)
+    {
+        if (tokens[i] == "pipelined")
+            pipelined = true;
+        else if (tokens[i] == "circles")
+            renderMode = ParticleRenderMode::Circles;
+        else if (tokens[i] == "sprites")
+            renderMode = ParticleRenderMode::Sprites;
+        else if (tokens[i] == "instanced")
+            renderMode = ParticleRenderMode::Instanced;
+        else
+            std::cout << "Unknown gui option: " << tokens[i] << "\n";
+    }
+
+    gui->setPipelined(pipelined);
+    gui->setRenderMode(renderMode);
+
     gui->Run();
 }
 
@@ -150,6 +230,14 @@ void Ui::run()
                 bvhCommands(tokens);
             if (tokens[0] == "grid" || tokens[0] == "spatialhashing")
                 gridCommands(tokens);
+            if (tokens[0] == "sap" || tokens[0] == "sweepandprune")
+                sweepAndPruneCommands(tokens);
+            if (tokens[0] == "bruteforce" || tokens[0] == "brute")
+                bruteForceCommands(tokens);
+            if (tokens[0] == "workers" || tokens[0] == "threads")
+                workersCommands(tokens);
+            if (tokens[0] == "linedepth")
+                lineDepthCommands(tokens);
             if (tokens[0] == "help")
                 helpCommands(tokens);
             if (tokens[0] == "start")
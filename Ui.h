@@ -47,6 +47,38 @@ public:
     /// \param tokens Vectorul de subsiruri reprezentand comenzile.
     void gridCommands(std::vector<std::string>& tokens);
 
+    /// \brief Executa comenzile specifice sweep and prune.
+    ///
+    /// Aceasta functie primeste un vector de subsiruri reprezentand comenzile specifice sweep and prune
+    /// si le executa in contextul ParticleManager-ului.
+    ///
+    /// \param tokens Vectorul de subsiruri reprezentand comenzile.
+    void sweepAndPruneCommands(std::vector<std::string>& tokens);
+
+    /// \brief Executa comenzile specifice testului pe toate perechile.
+    ///
+    /// Aceasta functie primeste un vector de subsiruri reprezentand comenzile specifice testului pe toate perechile
+    /// si le executa in contextul ParticleManager-ului.
+    ///
+    /// \param tokens Vectorul de subsiruri reprezentand comenzile.
+    void bruteForceCommands(std::vector<std::string>& tokens);
+
+    /// \brief Executa comenzile pentru numarul de fire de executie.
+    ///
+    /// Aceasta functie seteaza numarul de fire suplimentare ale ParticleManager-ului (daca este dat)
+    /// si afiseaza numarul de fire folosite pentru fiecare cadru.
+    ///
+    /// \param tokens Vectorul de subsiruri reprezentand comenzile.
+    void workersCommands(std::vector<std::string>& tokens);
+
+    /// \brief Executa comenzile pentru adancimea liniilor desenate.
+    ///
+    /// Aceasta functie limiteaza numarul de niveluri ale arborelui QuadTree sau BVH desenate cand liniile sunt pornite
+    /// (0 = toate nivelurile).
+    ///
+    /// \param tokens Vectorul de subsiruri reprezentand comenzile.
+    void lineDepthCommands(std::vector<std::string>& tokens);
+
     /// \brief Executa comenzile specifice help.
     ///
     /// Aceasta functie primeste un vector de subsiruri reprezentand comenzile specifice help
@@ -1,3 +1,5 @@
+// Executabilul interactiv; benchmark-ul fara fereastra are propriul main in BenchmarkMain.cpp.
+#ifndef PARTICLE_BENCHMARK
 #include<iostream>
 #include "raylib.h"
 #include "ParticleManager.h"
@@ -22,4 +24,5 @@ int main()
 	filemanager.storeToFile(measureCollector);
 
 	return 0;
-}
\ No newline at end of file
+}
+#endif